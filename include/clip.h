@@ -0,0 +1,66 @@
+/*
+File: clip.h
+Playback of compressed LED animation clips stored in flash.
+
+Clips are made with tools/clip_encode.py. A clip is a const byte array,
+the RP2040 reads it straight from flash (XIP). Frames are decoded one at
+a time into the LED strip buffer, so playback needs no RAM per frame.
+
+Clip format (little-endian):
+  header  'L' 'C' version reserved
+          uint16 led_count, uint16 frame_count, uint16 frame_ms
+  frames  type byte: CLIP_FRAME_KEY starts from black, CLIP_FRAME_DELTA
+          from the previous frame, followed by ops until led_count LEDs
+          are covered:
+            00nnnnnn              skip n+1 LEDs
+            10nnnnnn r g b        n+1 LEDs of one color
+            11nnnnnn (r g b)*     n+1 LEDs of their own colors
+*/
+#ifndef CLIP_H
+#define CLIP_H
+
+#include <stdint.h>
+#include <Adafruit_NeoPixel.h>
+
+#define CLIP_VERSION     1
+#define CLIP_HEADER_SIZE 10
+
+#define CLIP_FRAME_KEY   0
+#define CLIP_FRAME_DELTA 1
+
+class ClipPlayer {
+ public:
+  ClipPlayer();
+
+  // Start a clip at its first frame. Returns false if the header is bad.
+  bool start(const uint8_t *clip, bool loop, uint32_t now_ms);
+  void stop();
+
+  bool is_playing() const { return _clip != nullptr; }
+  const uint8_t *clip() const { return _clip; }
+
+  // Decode the frames due at now_ms into the strip.
+  // Returns true if the strip changed and needs show().
+  bool update(Adafruit_NeoPixel &strip, uint32_t now_ms);
+
+  // Decode the next frame into the strip. Returns false at the end of
+  // the clip or on a broken frame.
+  bool decode_frame(Adafruit_NeoPixel &strip);
+
+  uint16_t led_count() const { return _led_count; }
+  uint16_t frame_count() const { return _frame_count; }
+  uint16_t frame_index() const { return _frame_index; }
+
+ private:
+  const uint8_t *_clip;
+  const uint8_t *_pos;  // next frame
+  bool _loop;
+
+  uint16_t _led_count;
+  uint16_t _frame_count;
+  uint16_t _frame_ms;
+  uint16_t _frame_index;
+  uint32_t _next_ms;
+};
+
+#endif  // CLIP_H
@@ -0,0 +1,48 @@
+/*
+File: clip_breathe.h
+Generated by tools/clip_encode.py, do not edit.
+
+59 LEDs, 100 frames, 40 ms per frame, 98 keyframes
+504 bytes, raw 17700 bytes (2.8 %)
+*/
+#ifndef CLIP_BREATHE_H
+#define CLIP_BREATHE_H
+
+#include <stdint.h>
+
+const uint8_t CLIP_BREATHE[] = {
+  0x4C, 0x43, 0x01, 0x00, 0x3B, 0x00, 0x64, 0x00, 0x28, 0x00, 0x00, 0xBA, 0x08, 0x06, 0x02, 0x01,
+  0x3A, 0x00, 0xBA, 0x09, 0x06, 0x03, 0x00, 0xBA, 0x0A, 0x07, 0x03, 0x00, 0xBA, 0x0B, 0x08, 0x03,
+  0x00, 0xBA, 0x0D, 0x09, 0x04, 0x00, 0xBA, 0x0F, 0x0B, 0x05, 0x00, 0xBA, 0x12, 0x0D, 0x06, 0x00,
+  0xBA, 0x14, 0x0F, 0x06, 0x00, 0xBA, 0x18, 0x12, 0x08, 0x00, 0xBA, 0x1B, 0x14, 0x09, 0x00, 0xBA,
+  0x1F, 0x17, 0x0A, 0x00, 0xBA, 0x23, 0x1A, 0x0B, 0x00, 0xBA, 0x28, 0x1E, 0x0D, 0x00, 0xBA, 0x2C,
+  0x21, 0x0E, 0x00, 0xBA, 0x31, 0x24, 0x10, 0x00, 0xBA, 0x36, 0x28, 0x12, 0x00, 0xBA, 0x3C, 0x2D,
+  0x14, 0x00, 0xBA, 0x41, 0x30, 0x15, 0x00, 0xBA, 0x47, 0x35, 0x17, 0x00, 0xBA, 0x4D, 0x39, 0x19,
+  0x00, 0xBA, 0x53, 0x3E, 0x1B, 0x00, 0xBA, 0x59, 0x42, 0x1D, 0x00, 0xBA, 0x5F, 0x47, 0x1F, 0x00,
+  0xBA, 0x66, 0x4C, 0x22, 0x00, 0xBA, 0x6C, 0x51, 0x24, 0x00, 0xBA, 0x72, 0x55, 0x26, 0x00, 0xBA,
+  0x79, 0x5A, 0x28, 0x00, 0xBA, 0x7F, 0x5F, 0x2A, 0x00, 0xBA, 0x85, 0x63, 0x2C, 0x00, 0xBA, 0x8B,
+  0x68, 0x2E, 0x00, 0xBA, 0x91, 0x6C, 0x30, 0x00, 0xBA, 0x97, 0x71, 0x32, 0x00, 0xBA, 0x9C, 0x75,
+  0x34, 0x00, 0xBA, 0xA2, 0x79, 0x36, 0x00, 0xBA, 0xA7, 0x7D, 0x37, 0x00, 0xBA, 0xAC, 0x81, 0x39,
+  0x00, 0xBA, 0xB0, 0x84, 0x3A, 0x00, 0xBA, 0xB5, 0x87, 0x3C, 0x00, 0xBA, 0xB9, 0x8A, 0x3D, 0x00,
+  0xBA, 0xBD, 0x8D, 0x3F, 0x00, 0xBA, 0xC0, 0x90, 0x40, 0x00, 0xBA, 0xC4, 0x93, 0x41, 0x00, 0xBA,
+  0xC6, 0x94, 0x42, 0x00, 0xBA, 0xC9, 0x96, 0x43, 0x00, 0xBA, 0xCB, 0x98, 0x43, 0x00, 0xBA, 0xCD,
+  0x99, 0x44, 0x00, 0xBA, 0xCE, 0x9A, 0x44, 0x00, 0xBA, 0xCF, 0x9B, 0x45, 0x00, 0xBA, 0xD0, 0x9C,
+  0x45, 0x00, 0xBA, 0xD0, 0x9C, 0x45, 0x01, 0x3A, 0x00, 0xBA, 0xCF, 0x9B, 0x45, 0x00, 0xBA, 0xCE,
+  0x9A, 0x44, 0x00, 0xBA, 0xCD, 0x99, 0x44, 0x00, 0xBA, 0xCB, 0x98, 0x43, 0x00, 0xBA, 0xC9, 0x96,
+  0x43, 0x00, 0xBA, 0xC6, 0x94, 0x42, 0x00, 0xBA, 0xC4, 0x93, 0x41, 0x00, 0xBA, 0xC0, 0x90, 0x40,
+  0x00, 0xBA, 0xBD, 0x8D, 0x3F, 0x00, 0xBA, 0xB9, 0x8A, 0x3D, 0x00, 0xBA, 0xB5, 0x87, 0x3C, 0x00,
+  0xBA, 0xB0, 0x84, 0x3A, 0x00, 0xBA, 0xAC, 0x81, 0x39, 0x00, 0xBA, 0xA7, 0x7D, 0x37, 0x00, 0xBA,
+  0xA2, 0x79, 0x36, 0x00, 0xBA, 0x9C, 0x75, 0x34, 0x00, 0xBA, 0x97, 0x71, 0x32, 0x00, 0xBA, 0x91,
+  0x6C, 0x30, 0x00, 0xBA, 0x8B, 0x68, 0x2E, 0x00, 0xBA, 0x85, 0x63, 0x2C, 0x00, 0xBA, 0x7F, 0x5F,
+  0x2A, 0x00, 0xBA, 0x79, 0x5A, 0x28, 0x00, 0xBA, 0x72, 0x55, 0x26, 0x00, 0xBA, 0x6C, 0x51, 0x24,
+  0x00, 0xBA, 0x66, 0x4C, 0x22, 0x00, 0xBA, 0x5F, 0x47, 0x1F, 0x00, 0xBA, 0x59, 0x42, 0x1D, 0x00,
+  0xBA, 0x53, 0x3E, 0x1B, 0x00, 0xBA, 0x4D, 0x39, 0x19, 0x00, 0xBA, 0x47, 0x35, 0x17, 0x00, 0xBA,
+  0x41, 0x30, 0x15, 0x00, 0xBA, 0x3C, 0x2D, 0x14, 0x00, 0xBA, 0x36, 0x28, 0x12, 0x00, 0xBA, 0x31,
+  0x24, 0x10, 0x00, 0xBA, 0x2C, 0x21, 0x0E, 0x00, 0xBA, 0x28, 0x1E, 0x0D, 0x00, 0xBA, 0x23, 0x1A,
+  0x0B, 0x00, 0xBA, 0x1F, 0x17, 0x0A, 0x00, 0xBA, 0x1B, 0x14, 0x09, 0x00, 0xBA, 0x18, 0x12, 0x08,
+  0x00, 0xBA, 0x14, 0x0F, 0x06, 0x00, 0xBA, 0x12, 0x0D, 0x06, 0x00, 0xBA, 0x0F, 0x0B, 0x05, 0x00,
+  0xBA, 0x0D, 0x09, 0x04, 0x00, 0xBA, 0x0B, 0x08, 0x03, 0x00, 0xBA, 0x0A, 0x07, 0x03, 0x00, 0xBA,
+  0x09, 0x06, 0x03, 0x00, 0xBA, 0x08, 0x06, 0x02,
+};
+
+#endif  // CLIP_BREATHE_H
@@ -0,0 +1,120 @@
+/*
+File: clip_comet.h
+Generated by tools/clip_encode.py, do not edit.
+
+59 LEDs, 59 frames, 30 ms per frame, 59 keyframes
+1660 bytes, raw 10443 bytes (15.9 %)
+*/
+#ifndef CLIP_COMET_H
+#define CLIP_COMET_H
+
+#include <stdint.h>
+
+const uint8_t CLIP_COMET[] = {
+  0x4C, 0x43, 0x01, 0x00, 0x3B, 0x00, 0x3B, 0x00, 0x1E, 0x00, 0x00, 0xC0, 0x3F, 0x7F, 0xFF, 0x32,
+  0xC6, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F,
+  0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x00, 0xC1, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0xC5,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x00, 0xC2, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0xC4, 0x00,
+  0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x00, 0xC3,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0xC3, 0x00, 0x00,
+  0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x00, 0xC4, 0x03, 0x07, 0x0F, 0x07,
+  0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0xC2, 0x00, 0x00, 0x01,
+  0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x00, 0xC5, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F,
+  0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0xC1, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x00, 0xC6, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F,
+  0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0xC0, 0x00, 0x00, 0x01, 0x00, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x32, 0x00, 0x00, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x31, 0x00, 0x01, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x30, 0x00, 0x02, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x2F, 0x00, 0x03, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x2E, 0x00, 0x04, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x2D, 0x00, 0x05, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x2C, 0x00, 0x06, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x2B, 0x00, 0x07, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x2A, 0x00, 0x08, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x29, 0x00, 0x09, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x28, 0x00, 0x0A, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x27, 0x00, 0x0B, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x26, 0x00, 0x0C, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x25, 0x00, 0x0D, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x24, 0x00, 0x0E, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x23, 0x00, 0x0F, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x22, 0x00, 0x10, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x21, 0x00, 0x11, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x20, 0x00, 0x12, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x1F, 0x00, 0x13, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x1E, 0x00, 0x14, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x1D, 0x00, 0x15, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x1C, 0x00, 0x16, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x1B, 0x00, 0x17, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x1A, 0x00, 0x18, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x19, 0x00, 0x19, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x18, 0x00, 0x1A, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x17, 0x00, 0x1B, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x16, 0x00, 0x1C, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x15, 0x00, 0x1D, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x14, 0x00, 0x1E, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x13, 0x00, 0x1F, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x12, 0x00, 0x20, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x11, 0x00, 0x21, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x10, 0x00, 0x22, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x0F, 0x00, 0x23, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x0E, 0x00, 0x24, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x0D, 0x00, 0x25, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x0C, 0x00, 0x26, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x0B, 0x00, 0x27, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x0A, 0x00, 0x28, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x09, 0x00, 0x29, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x08, 0x00, 0x2A, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x07, 0x00, 0x2B, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x06, 0x00, 0x2C, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x05, 0x00, 0x2D, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x04, 0x00, 0x2E, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x03, 0x00, 0x2F, 0xC7,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F,
+  0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF, 0x02, 0x00, 0x30, 0xC7, 0x00, 0x00, 0x01, 0x00,
+  0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F,
+  0x7F, 0x3F, 0x7F, 0xFF, 0x01, 0x00, 0x31, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03,
+  0x07, 0x03, 0x07, 0x0F, 0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+  0x00, 0x00, 0x32, 0xC7, 0x00, 0x00, 0x01, 0x00, 0x01, 0x03, 0x01, 0x03, 0x07, 0x03, 0x07, 0x0F,
+  0x07, 0x0F, 0x1F, 0x0F, 0x1F, 0x3F, 0x1F, 0x3F, 0x7F, 0x3F, 0x7F, 0xFF,
+};
+
+#endif  // CLIP_COMET_H
@@ -0,0 +1,85 @@
+/*
+File: governor.h
+Frame time budget governor for the LED effects.
+
+Every rendered frame (pixel updates + show()) is measured as cost per
+render period: its cost spread over the time since the previous frame,
+at least one period. show() of a long strip costs the same on every
+level, so the levels render fewer frames per second instead:
+  - frame_due() allows one frame per frame_period_us(): every period on
+    QUALITY_HIGH, every 2nd on QUALITY_MEDIUM, every 4th on QUALITY_LOW.
+  - The effects with their own delay set pixel_step() pixels per step,
+    so there are fewer steps and show() calls per wipe.
+The last read_reserve_us of the period are the radar's: the budget is
+the rest, and frame_due() keeps read_reserve_us after every frame free
+for radar.read().
+  - 2 frames in a row over the budget: one quality level down.
+  - 50 frames in a row under half the budget: one quality level up.
+*/
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <stdint.h>
+#include "latency_stats.h"
+
+enum Quality_level : uint8_t {
+  QUALITY_LOW = 0,     // 4 pixels per step, a frame every 4th period
+  QUALITY_MEDIUM = 1,  // 2 pixels per step, a frame every 2nd period
+  QUALITY_HIGH = 2,    // every pixel, a frame every period
+};
+
+#define QUALITY_LEVELS 3
+
+class FrameGovernor {
+ public:
+  explicit FrameGovernor(uint32_t period_us = 20000, uint32_t read_reserve_us = 2000);
+
+  // Call before the pixels are set and after show()
+  void frame_start(uint32_t now_us);
+  void frame_end(uint32_t now_us);
+
+  // True if the next frame may start: frame_period_us() after the start
+  // of the last frame and read_reserve_us after its end
+  bool frame_due(uint32_t now_us) const;
+
+  // Time between two frames on the current level: 1, 2 or 4 periods
+  uint32_t frame_period_us() const { return _period_us << (QUALITY_HIGH - _level); }
+
+  Quality_level level() const { return _level; }
+
+  // Pixels set per effect step on the current level: 1, 2 or 4
+  uint8_t pixel_step() const { return 1 << (QUALITY_HIGH - _level); }
+
+  uint32_t budget_us() const { return _period_us - _read_reserve_us; }
+
+  // Frames over the budget, total and on one level
+  uint32_t overruns() const;
+  uint32_t overruns(Quality_level level) const { return _overruns[level]; }
+
+  // Frames started less than read_reserve_us after the previous one
+  uint32_t reserve_misses() const { return _reserve_misses; }
+
+  uint32_t frames() const { return _cost.count; }
+
+  // Render cost per frame and per render period
+  const Latency_stats &cost() const { return _cost; }
+  const Latency_stats &period_cost() const { return _period_cost; }
+
+ private:
+  uint32_t _period_us;
+  uint32_t _read_reserve_us;
+
+  Quality_level _level;
+  uint32_t _start_us;
+  uint32_t _last_start_us;  // of the last frame_end()
+  uint32_t _last_end_us;
+  uint8_t _over_in_row;
+  uint8_t _under_in_row;
+
+  uint32_t _overruns[QUALITY_LEVELS];
+  uint32_t _reserve_misses;
+  Latency_stats _cost;
+  Latency_stats _period_cost;
+};
+
+#endif  // GOVERNOR_H
@@ -0,0 +1,66 @@
+/*
+File: idle.h
+Idle state of the main loop while the room is empty.
+
+  ACTIVE -> IDLE: no target for timeout_ms and the strip is dark.
+  IDLE -> ACTIVE: wake(), a radar frame with a target or a rising OUT pin.
+
+In the idle state the loop renders nothing and sleeps until the next
+interrupt (UART RX, OUT pin). Radar frames without a target keep it
+idle. The first lit frame after wake() gives the wake to light latency.
+*/
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdint.h>
+#include "latency_stats.h"
+
+class IdleMonitor {
+ public:
+  explicit IdleMonitor(uint32_t timeout_ms = 30000);
+
+  // 0 never goes idle
+  void set_timeout(uint32_t timeout_ms) { _timeout_ms = timeout_ms; }
+
+  // Radar frame: target present or not, strip dark or not
+  void frame(bool is_present, bool is_dark, uint32_t now_ms);
+
+  // Target detected, event_us is the time of the frame or pin edge
+  void wake(uint32_t event_us, uint32_t now_ms);
+
+  // A lit frame was shown
+  void lit(uint32_t now_us);
+
+  // Time slept in the idle state
+  void slept(uint32_t sleep_us) { _sleep_us += sleep_us; }
+
+  bool idle() const { return _is_idle; }
+
+  // Woken, waiting for the first lit frame
+  bool waking() const { return _is_waking; }
+
+  // Time in the idle state, the current one included
+  uint32_t idle_ms(uint32_t now_ms) const;
+  uint64_t sleep_us() const { return _sleep_us; }
+  uint32_t idle_entries() const { return _idle_entries; }
+
+  const Latency_stats &wake_to_light() const { return _wake_to_light; }
+
+ private:
+  uint32_t _timeout_ms;
+
+  bool _is_idle;
+  bool _is_empty;
+  uint32_t _empty_since_ms;
+  uint32_t _idle_since_ms;
+
+  bool _is_waking;
+  uint32_t _wake_us;
+
+  uint32_t _idle_ms;
+  uint64_t _sleep_us;
+  uint32_t _idle_entries;
+  Latency_stats _wake_to_light;
+};
+
+#endif  // IDLE_H
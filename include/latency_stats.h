@@ -0,0 +1,21 @@
+/*
+File: latency_stats.h
+Count, min, max and running average of a time in microseconds,
+for latencies and CPU cost per frame.
+*/
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <stdint.h>
+
+// Latency statistics in microseconds
+struct Latency_stats {
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint32_t avg_us;  // EWMA 1/8
+
+  void add(uint32_t latency_us);
+};
+
+#endif  // LATENCY_STATS_H
@@ -0,0 +1,86 @@
+/*
+File: led_output.h
+LED output backends.
+
+submit() hands over a frame of 3 bytes per LED in wire order (GRB, like
+Adafruit_NeoPixel::getPixels() with NEO_GRB) and returns as soon as the
+backend has taken it.
+
+Ws2812Output is double buffered: submit() encodes the frame into the
+back buffer, the front buffer is on the wire. When the wire is free the
+buffers swap and the transfer starts, otherwise the frame waits until
+service() or the next submit(). A newer frame replaces a waiting one.
+The hardware part (start a transfer, clock) is left to the subclass:
+PIO + DMA on the RP2040, a mock on the host.
+*/
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <stdint.h>
+
+#define LED_OUTPUT_MAX_LEDS 128
+
+// WS2812 at 800 kHz: 24 bits of 1.25 us per LED, latch after 280 us low
+#define WS2812_LED_US   30
+#define WS2812_RESET_US 300
+
+struct Led_output_stats {
+  uint32_t submits;  // frames handed over
+  uint32_t frames;   // frames sent
+  uint32_t dropped;  // waiting frames replaced by a newer one
+};
+
+class LedOutput {
+ public:
+  virtual ~LedOutput() {}
+
+  virtual bool begin() { return true; }
+
+  // Hand over a frame, grb has 3 bytes per LED
+  virtual void submit(const uint8_t *grb, uint16_t count) = 0;
+
+  // Start a waiting frame if the wire is free, call from loop()
+  virtual void service() {}
+
+  // A frame is on the wire or waiting
+  virtual bool busy() { return false; }
+
+  const Led_output_stats &stats() const { return _stats; }
+
+ protected:
+  Led_output_stats _stats = {0, 0, 0};
+};
+
+// One word per LED for the PIO ws2812 program: G, R, B from bit 31 down,
+// the state machine shifts out 24 bits to the left
+void Ws2812_encode(const uint8_t *grb, uint16_t count, uint32_t *words);
+
+class Ws2812Output : public LedOutput {
+ public:
+  void submit(const uint8_t *grb, uint16_t count) override;
+  void service() override;
+  bool busy() override { return _pending || _transmitting(); }
+
+ protected:
+  Ws2812Output();
+
+  // Start sending words, returns at once
+  virtual void _transmit(const uint32_t *words, uint16_t count) = 0;
+  virtual uint32_t _now_us() = 0;
+
+  // Until the last bit and the latch are out
+  bool _transmitting() { return _now_us() - _start_us < _wire_us; }
+
+ private:
+  void _swap_and_send();
+
+  uint32_t _buffers[2][LED_OUTPUT_MAX_LEDS];
+  uint8_t _back;
+  uint16_t _back_count;
+  bool _pending;
+
+  uint32_t _start_us;
+  uint32_t _wire_us;
+};
+
+#endif  // LED_OUTPUT_H
@@ -0,0 +1,33 @@
+/*
+File: led_output_neopixel.h
+LED output through Adafruit_NeoPixel::show(), blocks until the frame is
+sent.
+*/
+#ifndef LED_OUTPUT_NEOPIXEL_H
+#define LED_OUTPUT_NEOPIXEL_H
+
+#include <string.h>
+#include <Adafruit_NeoPixel.h>
+#include "led_output.h"
+
+class NeoPixelOutput : public LedOutput {
+ public:
+  explicit NeoPixelOutput(Adafruit_NeoPixel &strip) : _strip(strip) {}
+
+  void submit(const uint8_t *grb, uint16_t count) override {
+    uint8_t *pixels = _strip.getPixels();
+    if (grb != pixels) {
+      uint16_t max = _strip.numPixels();
+      memcpy(pixels, grb, 3 * (count < max ? count : max));
+    }
+
+    _stats.submits++;
+    _strip.show();
+    _stats.frames++;
+  }
+
+ private:
+  Adafruit_NeoPixel &_strip;
+};
+
+#endif  // LED_OUTPUT_NEOPIXEL_H
@@ -0,0 +1,35 @@
+/*
+File: led_output_rp2040.h
+WS2812 output of the RP2040: a PIO state machine runs the ws2812
+program, DMA feeds it from the front buffer. submit() only encodes the
+frame, the CPU and the interrupts stay free while it is sent.
+*/
+#ifndef LED_OUTPUT_RP2040_H
+#define LED_OUTPUT_RP2040_H
+
+#if defined(ARDUINO_ARCH_RP2040)
+
+#include <hardware/pio.h>
+#include "led_output.h"
+
+class Rp2040PioOutput : public Ws2812Output {
+ public:
+  explicit Rp2040PioOutput(uint8_t pin, PIO pio = pio1);
+
+  // Claims a state machine and a DMA channel, false if none is free
+  bool begin() override;
+
+ protected:
+  void _transmit(const uint32_t *words, uint16_t count) override;
+  uint32_t _now_us() override;
+
+ private:
+  uint8_t _pin;
+  PIO _pio;
+  int _sm;
+  int _dma;
+};
+
+#endif  // ARDUINO_ARCH_RP2040
+
+#endif  // LED_OUTPUT_RP2040_H
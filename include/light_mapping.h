@@ -0,0 +1,68 @@
+/*
+File: light_mapping.h
+Continuous light parameters from the radar data.
+
+Every radar frame sets new targets:
+  hue         target distance, near = red, far = blue
+  brightness  strongest target energy, 0 without a target
+  position    target distance as position on the strip
+  spread      half width of the light around the position, wider for
+              a moving target
+  gate field  energy per gate (Engineering mode only)
+update() moves the render parameters towards the targets with fixed
+point smoothing, at the render rate and independent of the radar frame
+rate. map() draws them: the gate energies go through a precomputed
+gate to pixel weight table, the target adds a light of spread pixels at
+position.
+*/
+#ifndef LIGHT_MAPPING_H
+#define LIGHT_MAPPING_H
+
+#include <stdint.h>
+
+#define LIGHT_MAPPING_GATES    9
+#define LIGHT_MAPPING_MAX_LEDS 128
+
+// Smoothed render parameters, Q8.8
+struct Light_params {
+  uint16_t hue;         // 0-170 << 8, red to blue
+  uint16_t brightness;  // 0-255 << 8
+  uint16_t position;    // pixel << 8
+  uint16_t spread;      // pixels << 8
+  uint16_t gate[LIGHT_MAPPING_GATES];  // energy 0-255 << 8
+};
+
+class LightMapper {
+ public:
+  // max_distance_cm is the far end of the strip and of the hue range
+  explicit LightMapper(uint16_t num_leds, uint16_t max_distance_cm = 600, uint16_t smoothing_ms = 300);
+
+  // New radar frame. Gate energies 0-100 or nullptr without Engineering mode.
+  void set_target(uint8_t target_state,
+                  uint16_t moving_distance, uint8_t moving_energy,
+                  uint16_t stationary_distance, uint8_t stationary_energy,
+                  const uint8_t *moving_gates = nullptr, const uint8_t *stationary_gates = nullptr);
+
+  // Move the render parameters towards the targets, dt_ms since the last update
+  void update(uint32_t dt_ms);
+
+  // Draw one frame: 3 bytes R, G, B per LED
+  void map(uint8_t *rgb) const;
+
+  const Light_params &params() const { return _params; }
+  uint16_t num_leds() const { return _num_leds; }
+
+ private:
+  uint16_t _num_leds;
+  uint16_t _max_distance_cm;
+  uint16_t _smoothing_ms;
+
+  Light_params _target;
+  Light_params _params;
+
+  // Gate to pixel weights, Q8, the weights of a pixel add up to 255
+  // (255 - frac and frac), so the field is 255/256 of the gate energy
+  uint8_t _weights[LIGHT_MAPPING_MAX_LEDS][LIGHT_MAPPING_GATES];
+};
+
+#endif  // LIGHT_MAPPING_H
@@ -0,0 +1,54 @@
+/*
+File: presence.h
+Arbitration between the radar OUT pin and the radar UART frames.
+
+The OUT pin goes high as soon as the radar detects a target, the UART
+frame with the target state arrives later. The pin switches the light
+on at once (fast path), the UART frames take over when they arrive.
+If both disagree:
+  - pin high, UART no target: the pin wins for pin_hold_ms after the
+    rising edge, the frame may be older than the detection.
+  - pin low, UART target: the UART wins.
+  - no UART frame for uart_timeout_ms: the pin decides alone.
+Pin edges are timestamped with the time of the edge, not the time they
+are handled. An edge older than the last UART frame doesn't switch the
+light on, the frame is newer.
+*/
+#ifndef PRESENCE_H
+#define PRESENCE_H
+
+#include <stdint.h>
+
+class PresenceArbiter {
+ public:
+  explicit PresenceArbiter(uint32_t pin_hold_ms = 1000, uint32_t uart_timeout_ms = 2000);
+
+  // OUT pin changed at edge_ms. Returns true if the light should switch on now.
+  bool pin_edge(bool level, uint32_t edge_ms);
+
+  // UART frame received. Returns true if a target is present.
+  bool uart_frame(uint8_t target_state, uint32_t now_ms);
+
+  // Returns true if a target is present.
+  bool present(uint32_t now_ms) const;
+
+  bool pin_level() const { return _pin_level; }
+
+  // Number of UART frames which disagreed with the OUT pin
+  uint32_t disagreements() const { return _disagreements; }
+
+ private:
+  uint32_t _pin_hold_ms;
+  uint32_t _uart_timeout_ms;
+
+  bool _pin_level;
+  uint32_t _pin_rise_ms;
+
+  bool _uart_present;
+  bool _uart_seen;
+  uint32_t _uart_frame_ms;
+
+  uint32_t _disagreements;
+};
+
+#endif  // PRESENCE_H
@@ -0,0 +1,266 @@
+/*
+File: radar_history.h
+Fixed size history of radar samples with sliding time windows.
+
+The last CAPACITY samples are kept in a ring buffer. Each of the WINDOWS
+time windows (for example the last 2 s and the last 10 s) keeps its
+aggregates up to date on every add(): running sums, and min/max with
+monotonic deques. Window queries are O(1) whatever the window length,
+add() is amortized O(WINDOWS * metrics). No dynamic allocation.
+
+Windows move on add() and expire(). With the radar change only mode,
+call expire() before a query if no frame came for a while.
+
+Usage:
+  RadarHistory<128> history;
+  history.set_window(0, 2000);
+  history.add(sample);
+  history.trend(0, METRIC_MOVING_DISTANCE);  // < 0 approaching
+*/
+#ifndef RADAR_HISTORY_H
+#define RADAR_HISTORY_H
+
+#include <stdint.h>
+
+// Compact radar sample, 12 bytes
+struct Radar_sample {
+  uint32_t time_ms;
+  uint16_t moving_distance;      // cm
+  uint16_t stationary_distance;  // cm
+  uint8_t target_state;          // 0 no target, 1 moving, 2 stationary, 3 both
+  uint8_t moving_energy;         // 0-100
+  uint8_t stationary_energy;     // 0-100
+};
+
+enum Radar_metric : uint8_t {
+  METRIC_MOVING_DISTANCE = 0,
+  METRIC_STATIONARY_DISTANCE,
+  METRIC_MOVING_ENERGY,
+  METRIC_STATIONARY_ENERGY,
+  METRIC_COUNT
+};
+
+inline uint16_t Radar_sample_value(const Radar_sample &sample, uint8_t metric) {
+  switch (metric) {
+    case METRIC_MOVING_DISTANCE:
+      return sample.moving_distance;
+    case METRIC_STATIONARY_DISTANCE:
+      return sample.stationary_distance;
+    case METRIC_MOVING_ENERGY:
+      return sample.moving_energy;
+    default:
+      return sample.stationary_energy;
+  }
+}
+
+// CAPACITY must be a power of two, sequence numbers wrap at 65536
+template <uint16_t CAPACITY, uint8_t WINDOWS = 2>
+class RadarHistory {
+  static_assert(CAPACITY >= 2 && CAPACITY <= 32768 && (CAPACITY & (CAPACITY - 1)) == 0,
+                "CAPACITY must be a power of two up to 32768");
+  static_assert(WINDOWS >= 1, "at least one window");
+
+ public:
+  RadarHistory() : _next(0), _size(0), _present(false), _present_since_ms(0) {
+    for (uint8_t w = 0; w < WINDOWS; w++) {
+      _windows[w].length_ms = 1000;
+      _clear(_windows[w]);
+    }
+  }
+
+  // Window length in ms. Rebuilds the window from the stored samples.
+  void set_window(uint8_t window, uint32_t length_ms) {
+    if (window >= WINDOWS || length_ms == 0) {
+      return;
+    }
+
+    Window &win = _windows[window];
+    win.length_ms = length_ms;
+    _clear(win);
+
+    uint16_t first = _next - _size;
+    for (uint16_t i = 0; i < _size; i++) {
+      _push(win, first + i);
+    }
+    if (_size) {
+      _expire(win, _sample(_next - 1).time_ms);
+    }
+  }
+
+  void add(const Radar_sample &sample) {
+    // Full: the oldest sample leaves the ring and every window
+    if (_size == CAPACITY) {
+      uint16_t oldest = _next - CAPACITY;
+      for (uint8_t w = 0; w < WINDOWS; w++) {
+        if (_windows[w].count && _windows[w].start == oldest) {
+          _pop(_windows[w]);
+        }
+      }
+      _size--;
+    }
+
+    uint16_t seq = _next++;
+    _samples[seq & (CAPACITY - 1)] = sample;
+    _size++;
+
+    for (uint8_t w = 0; w < WINDOWS; w++) {
+      _push(_windows[w], seq);
+      _expire(_windows[w], sample.time_ms);
+    }
+
+    // Presence dwell time
+    if (sample.target_state == 0) {
+      _present = false;
+    } else if (!_present) {
+      _present = true;
+      _present_since_ms = sample.time_ms;
+    }
+  }
+
+  // Move the windows without a new sample
+  void expire(uint32_t now_ms) {
+    for (uint8_t w = 0; w < WINDOWS; w++) {
+      _expire(_windows[w], now_ms);
+    }
+  }
+
+  uint16_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  // age 0 = latest sample
+  const Radar_sample &latest(uint16_t age = 0) const { return _sample(_next - 1 - age); }
+
+  // Window queries, O(1). Empty window: 0.
+  uint16_t count(uint8_t window) const { return _windows[window].count; }
+
+  uint16_t min(uint8_t window, uint8_t metric) const {
+    const Window &win = _windows[window];
+    return win.count ? _value(win.min[metric].front(), metric) : 0;
+  }
+
+  uint16_t max(uint8_t window, uint8_t metric) const {
+    const Window &win = _windows[window];
+    return win.count ? _value(win.max[metric].front(), metric) : 0;
+  }
+
+  uint32_t sum(uint8_t window, uint8_t metric) const { return _windows[window].sum[metric]; }
+
+  uint16_t average(uint8_t window, uint8_t metric) const {
+    const Window &win = _windows[window];
+    return win.count ? win.sum[metric] / win.count : 0;
+  }
+
+  // Latest minus oldest value in the window.
+  // Distance < 0: approaching, > 0: leaving. Energy > 0: rising.
+  int32_t trend(uint8_t window, uint8_t metric) const {
+    const Window &win = _windows[window];
+    if (!win.count) {
+      return 0;
+    }
+    return (int32_t)_value(_next - 1, metric) - (int32_t)_value(win.start, metric);
+  }
+
+  // Oldest sample in the window
+  const Radar_sample &oldest(uint8_t window) const { return _sample(_windows[window].start); }
+
+  // Time since the target state became non zero, 0 without a target
+  uint32_t dwell_ms(uint32_t now_ms) const { return _present ? now_ms - _present_since_ms : 0; }
+
+ private:
+  // Sequence numbers of a window, ring of CAPACITY
+  struct Deque {
+    uint16_t items[CAPACITY];
+    uint16_t head;
+    uint16_t size;
+
+    uint16_t front() const { return items[head]; }
+    uint16_t back() const { return items[(head + size - 1) & (CAPACITY - 1)]; }
+    void push_back(uint16_t seq) { items[(head + size++) & (CAPACITY - 1)] = seq; }
+    void pop_back() { size--; }
+    void pop_front() {
+      head = (head + 1) & (CAPACITY - 1);
+      size--;
+    }
+  };
+
+  struct Window {
+    uint32_t length_ms;
+    uint16_t start;  // sequence number of the oldest sample
+    uint16_t count;
+    uint32_t sum[METRIC_COUNT];
+    Deque min[METRIC_COUNT];  // increasing values
+    Deque max[METRIC_COUNT];  // decreasing values
+  };
+
+  const Radar_sample &_sample(uint16_t seq) const { return _samples[seq & (CAPACITY - 1)]; }
+
+  uint16_t _value(uint16_t seq, uint8_t metric) const { return Radar_sample_value(_sample(seq), metric); }
+
+  void _clear(Window &win) {
+    win.start = _next;
+    win.count = 0;
+    for (uint8_t m = 0; m < METRIC_COUNT; m++) {
+      win.sum[m] = 0;
+      win.min[m].head = win.min[m].size = 0;
+      win.max[m].head = win.max[m].size = 0;
+    }
+  }
+
+  void _push(Window &win, uint16_t seq) {
+    if (!win.count) {
+      win.start = seq;
+    }
+    win.count++;
+
+    for (uint8_t m = 0; m < METRIC_COUNT; m++) {
+      uint16_t value = _value(seq, m);
+      win.sum[m] += value;
+
+      while (win.min[m].size && _value(win.min[m].back(), m) >= value) {
+        win.min[m].pop_back();
+      }
+      win.min[m].push_back(seq);
+
+      while (win.max[m].size && _value(win.max[m].back(), m) <= value) {
+        win.max[m].pop_back();
+      }
+      win.max[m].push_back(seq);
+    }
+  }
+
+  // Remove the oldest sample of the window
+  void _pop(Window &win) {
+    uint16_t seq = win.start;
+
+    for (uint8_t m = 0; m < METRIC_COUNT; m++) {
+      win.sum[m] -= _value(seq, m);
+
+      if (win.min[m].size && win.min[m].front() == seq) {
+        win.min[m].pop_front();
+      }
+      if (win.max[m].size && win.max[m].front() == seq) {
+        win.max[m].pop_front();
+      }
+    }
+
+    win.start++;
+    win.count--;
+  }
+
+  void _expire(Window &win, uint32_t now_ms) {
+    while (win.count && now_ms - _sample(win.start).time_ms >= win.length_ms) {
+      _pop(win);
+    }
+  }
+
+  Radar_sample _samples[CAPACITY];
+  uint16_t _next;  // sequence number of the next sample
+  uint16_t _size;
+
+  Window _windows[WINDOWS];
+
+  bool _present;
+  uint32_t _present_since_ms;
+};
+
+#endif  // RADAR_HISTORY_H
@@ -0,0 +1,155 @@
+#pragma once
+
+/*
+ * Per client send policy for the radar frames pushed to the websocket clients.
+ *
+ * Every client gets a maximum update rate. A new radar frame only marks the
+ * clients as pending, the frame itself is sent later by poll() once the client
+ * is due and its send queue is empty. If a newer frame arrives while a
+ * client is still pending, the older frame is coalesced into the newer one and
+ * counted as dropped for that client. So a slow client never makes the frame
+ * producer block or queue messages on its behalf.
+ *
+ * The header only depends on <stdint.h> so it can be used on the host as well.
+ * It has no locking, use it from one task only.
+ */
+
+#include <stdint.h>
+
+#define PUSH_POLICY_MAX_CLIENTS 8  // same as DEFAULT_MAX_WS_CLIENTS of the AsyncWebSocket
+
+/**
+ * @brief Send state of one websocket client
+ */
+struct ClientPushSlot {
+  bool used;               // slot is assigned to a client
+  bool pending;            // the latest frame was not yet sent to the client
+  uint32_t clientId;       // id of the websocket client
+  uint16_t minInterval;    // minimum time between two frames in ms
+  uint32_t lastSent;       // time the last frame was sent in ms
+  uint32_t sentFrames;     // frames sent to the client
+  uint32_t droppedFrames;  // frames coalesced before they could be sent
+};
+
+class ClientPushPolicy {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param minInterval default minimum time between two frames per client in ms
+   */
+  explicit ClientPushPolicy(uint16_t minInterval) : _minInterval(minInterval) {
+    for (uint8_t i = 0; i < PUSH_POLICY_MAX_CLIENTS; i++) {
+      _slots[i].used = false;
+    }
+  }
+
+  /**
+   * @brief Adds a client with the default update rate
+   *
+   * @return true The client was added
+   * @return false No free slot for the client
+   */
+  bool add(uint32_t clientId) {
+    for (uint8_t i = 0; i < PUSH_POLICY_MAX_CLIENTS; i++) {
+      if (!_slots[i].used) {
+        _slots[i].used          = true;
+        _slots[i].pending       = false;
+        _slots[i].clientId      = clientId;
+        _slots[i].minInterval   = _minInterval;
+        _slots[i].lastSent      = 0;
+        _slots[i].sentFrames    = 0;
+        _slots[i].droppedFrames = 0;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Removes a client
+   */
+  void remove(uint32_t clientId) {
+    ClientPushSlot *slot = find(clientId);
+    if (slot) {
+      slot->used = false;
+    }
+  }
+
+  /**
+   * @brief Set the minimum time between two frames for one client
+   */
+  void setMinInterval(uint32_t clientId, uint16_t minInterval) {
+    ClientPushSlot *slot = find(clientId);
+    if (slot) {
+      slot->minInterval = minInterval;
+    }
+  }
+
+  /**
+   * @brief A new frame is available, marks all clients as pending.
+   * Clients which did not get the previous frame count it as dropped.
+   */
+  void framePublished() {
+    for (uint8_t i = 0; i < PUSH_POLICY_MAX_CLIENTS; i++) {
+      if (!_slots[i].used) {
+        continue;
+      }
+
+      if (_slots[i].pending) {
+        _slots[i].droppedFrames++;
+      }
+      _slots[i].pending = true;
+    }
+  }
+
+  /**
+   * @brief Checks if the latest frame should be sent to a client now
+   *
+   * @param slot client slot
+   * @param now current time in ms
+   * @param queueBusy the send queue of the client is not empty
+   * @return true Send the latest frame to the client
+   * @return false Nothing to send or the client is not due yet
+   */
+  bool poll(ClientPushSlot &slot, uint32_t now, bool queueBusy) {
+    if (!slot.used || !slot.pending || queueBusy) {
+      return false;
+    }
+
+    if (slot.sentFrames && now - slot.lastSent < slot.minInterval) {
+      return false;
+    }
+
+    slot.pending  = false;
+    slot.lastSent = now;
+    slot.sentFrames++;
+    return true;
+  }
+
+  /**
+   * @brief Returns the slot of a client or NULL
+   */
+  ClientPushSlot *find(uint32_t clientId) {
+    for (uint8_t i = 0; i < PUSH_POLICY_MAX_CLIENTS; i++) {
+      if (_slots[i].used && _slots[i].clientId == clientId) {
+        return &_slots[i];
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Returns the slot at index 0 - PUSH_POLICY_MAX_CLIENTS-1
+   */
+  ClientPushSlot &slot(uint8_t index) {
+    return _slots[index];
+  }
+
+ private:
+  // default minimum time between two frames in ms
+  uint16_t _minInterval;
+
+  // send state per client
+  ClientPushSlot _slots[PUSH_POLICY_MAX_CLIENTS];
+};
@@ -9,6 +9,8 @@
 #include <WiFi.h>
 
 #include "LD2410.h"
+#include "ClientPushPolicy.h"
+#include "RadarFrame.h"
 
 AsyncWebServer server(80);
 AsyncWebSocket ws("/ws");
@@ -23,6 +25,22 @@ const char *password = "PASSWORD";
 // update websocket client if radar has been factory reset
 bool sendRadarSettings;
 
+// binary frame pushed to the clients for every radar frame
+uint8_t radarFrameBuffer[RADAR_FRAME_SIZE];
+size_t radarFrameLength;
+RadarFrame radarFrame;
+
+// max. 20 frames per second and client, slower clients get the latest frame only
+ClientPushPolicy pushPolicy(50);
+
+// websocket connects and disconnects, posted by onEvent() on the async_tcp
+// task and applied in loop(), so only loop() touches pushPolicy and the radar
+struct ClientEvent {
+  uint32_t clientId;
+  bool connected;
+};
+QueueHandle_t clientEvents;
+
 // handle incoming websocket messages
 void handleWebSocketMessage(void *arg, uint8_t *data, size_t len) {
   bool result = false;
@@ -106,43 +124,58 @@ void handleWebSocketMessage(void *arg, uint8_t *data, size_t len) {
   }
 }
 
-// Send cyclic radar data to the clients
+// Encode the cyclic radar data as latest binary frame for the clients
 void wsSendCyclicData() {
-  String radarDataJson;
-  StaticJsonDocument<768> doc;
-
   // Cyclic radar data
-  JsonObject radarData = doc.createNestedObject("radarData");
-  radarData.getOrAddMember("radarInEngineeringMode").set(radar.cyclicData.radarInEngineeringMode);
-  radarData.getOrAddMember("targetState").set(radar.cyclicData.targetState);
-  radarData.getOrAddMember("movingTargetDistance").set(radar.cyclicData.movingTargetDistance);
-  radarData.getOrAddMember("movingTargetEnergy").set(radar.cyclicData.movingTargetEnergy);
-  radarData.getOrAddMember("stationaryTargetDistance").set(radar.cyclicData.stationaryTargetDistance);
-  radarData.getOrAddMember("stationaryTargetEnergy").set(radar.cyclicData.stationaryTargetEnergy);
-  radarData.getOrAddMember("detectionDistance").set(radar.cyclicData.detectionDistance);
+  radarFrame.sequence++;
+  radarFrame.radarInEngineeringMode   = radar.cyclicData.radarInEngineeringMode;
+  radarFrame.targetState              = radar.cyclicData.targetState;
+  radarFrame.movingTargetDistance     = radar.cyclicData.movingTargetDistance;
+  radarFrame.movingTargetEnergy       = radar.cyclicData.movingTargetEnergy;
+  radarFrame.stationaryTargetDistance = radar.cyclicData.stationaryTargetDistance;
+  radarFrame.stationaryTargetEnergy   = radar.cyclicData.stationaryTargetEnergy;
+  radarFrame.detectionDistance        = radar.cyclicData.detectionDistance;
 
   // Engineering data
-  JsonObject radar_engData           = doc.createNestedObject("engineeringData");
-  JsonArray radar_engData_movEnergy  = radar_engData.createNestedArray("movingEnergyGateN");
-  JsonArray radar_engData_statEnergy = radar_engData.createNestedArray("stationaryEnergyGateN");
-
-  radar_engData.getOrAddMember("maxMovingGate").set(radar.engineeringData.maxMovingGate);
-  radar_engData.getOrAddMember("maxStationaryGate").set(radar.engineeringData.maxStationaryGate);
-
-  radar_engData.getOrAddMember("maxMovingEnergy").set(radar.engineeringData.maxMovingEnergy);
-  radar_engData.getOrAddMember("maxStationaryEnergy").set(radar.engineeringData.maxStationaryEnergy);
+  radarFrame.maxMovingGate       = radar.engineeringData.maxMovingGate;
+  radarFrame.maxStationaryGate   = radar.engineeringData.maxStationaryGate;
+  radarFrame.maxMovingEnergy     = radar.engineeringData.maxMovingEnergy;
+  radarFrame.maxStationaryEnergy = radar.engineeringData.maxStationaryEnergy;
 
   for (uint8_t gate = 0; gate <= 8; gate++) {
-    radar_engData_movEnergy.add(radar.engineeringData.movingEnergyGateN[gate]);
-    radar_engData_statEnergy.add(radar.engineeringData.stationaryEnergyGateN[gate]);
+    radarFrame.movingEnergyGateN[gate]     = radar.engineeringData.movingEnergyGateN[gate];
+    radarFrame.stationaryEnergyGateN[gate] = radar.engineeringData.stationaryEnergyGateN[gate];
   }
 
-  serializeJson(doc, radarDataJson);
-  ws.textAll(radarDataJson);
+  radarFrameLength = radarFrameEncode(radarFrame, radarFrameBuffer, sizeof(radarFrameBuffer));
+  pushPolicy.framePublished();
 }
 
-// Send radar firmware version to the websocket client
-void wsSendRadarFirmwareVersion() {
+// Send the latest binary frame to every client which is due and has nothing queued
+void wsPushPendingFrames() {
+  uint32_t now = millis();
+
+  for (uint8_t i = 0; i < PUSH_POLICY_MAX_CLIENTS; i++) {
+    ClientPushSlot &slot = pushPolicy.slot(i);
+    if (!slot.used || !slot.pending) {
+      continue;
+    }
+
+    AsyncWebSocketClient *client = ws.client(slot.clientId);
+    if (client == NULL) {
+      pushPolicy.remove(slot.clientId);
+      continue;
+    }
+
+    // coalesce as long as the previous message is still queued
+    if (pushPolicy.poll(slot, now, client->queueLen() > 0)) {
+      client->binary(radarFrameBuffer, radarFrameLength);
+    }
+  }
+}
+
+// Send radar firmware version to one or all websocket clients
+void wsSendRadarFirmwareVersion(AsyncWebSocketClient *client = NULL) {
   String firmwareVersionJson;
 
   StaticJsonDocument<512> doc;
@@ -154,17 +187,22 @@ void wsSendRadarFirmwareVersion() {
   firmwareVersion.getOrAddMember("bugFix").set(radar.firmwareVersion.bugFixVersion);
 
   serializeJson(doc, firmwareVersionJson);
-  ws.textAll(firmwareVersionJson);
+  if (client) {
+    client->text(firmwareVersionJson);
+  } else {
+    ws.textAll(firmwareVersionJson);
+  }
 }
 
-// Send radar settings to the websocket client
-void wsSendRadarSettings() {
+// Send radar settings to one or all websocket clients
+void wsSendRadarSettings(AsyncWebSocketClient *client = NULL) {
   String settingsJson;
 
   StaticJsonDocument<512> doc;
   JsonObject settings = doc.createNestedObject("settings");
 
-  radar.readParameter();
+  // served from the cached parameters, only read from the radar after a factory reset or restart
+  radar.updateParameter();
 
   settings.getOrAddMember("maxGate").set(radar.parameter.maxGate);
   settings.getOrAddMember("maxMovingGate").set(radar.parameter.maxMovingGate);
@@ -180,19 +218,50 @@ void wsSendRadarSettings() {
   }
 
   serializeJson(doc, settingsJson);
-  ws.textAll(settingsJson);
+  if (client) {
+    client->text(settingsJson);
+  } else {
+    ws.textAll(settingsJson);
+  }
+}
+
+// Apply the connects and disconnects of the websocket clients
+void wsApplyClientEvents() {
+  ClientEvent event;
+
+  while (xQueueReceive(clientEvents, &event, 0) == pdTRUE) {
+    if (event.connected) {
+      pushPolicy.add(event.clientId);
+
+      // may read the parameters from the radar, which loop() reads as well
+      if (AsyncWebSocketClient *client = ws.client(event.clientId)) {
+        wsSendRadarSettings(client);
+        wsSendRadarFirmwareVersion(client);
+      }
+      continue;
+    }
+
+    if (ClientPushSlot *slot = pushPolicy.find(event.clientId)) {
+      Serial.printf("Client #%u frames sent: %u, dropped: %u\n", event.clientId, slot->sentFrames, slot->droppedFrames);
+    }
+    pushPolicy.remove(event.clientId);
+  }
 }
 
 void onEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
              AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  ClientEvent event;
+
   switch (type) {
     case WS_EVT_CONNECT:
       Serial.printf("WebSocket client #%u connected from %s\n", client->id(), client->remoteIP().toString().c_str());
-      wsSendRadarSettings();
-      wsSendRadarFirmwareVersion();
+      event = {client->id(), true};
+      xQueueSend(clientEvents, &event, 0);
       break;
     case WS_EVT_DISCONNECT:
       Serial.printf("WebSocket client #%u disconnected\n", client->id());
+      event = {client->id(), false};
+      xQueueSend(clientEvents, &event, 0);
       break;
     case WS_EVT_DATA:
       handleWebSocketMessage(arg, data, len);
@@ -251,6 +320,14 @@ void setup() {
     Serial.println("Failed to get firmware version and parameters from radar");
   }
 
+  // Only push frames to the clients which differ from the last pushed frame.
+  // Smaller deadbands pass the noise of an empty room, 2 % per gate still delivers 99 % of the frames.
+  radar.setDeadband(10, 5);
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    radar.setGateDeadband(gate, 6, 6);
+  }
+  radar.setChangeOnly(true, 1000);
+
   // Initialize SPIFFS
   if (!SPIFFS.begin()) {
     Serial.println("An Error has occurred while mounting SPIFFS");
@@ -274,6 +351,7 @@ void setup() {
     request->send(SPIFFS, "/index.html", String(), false);
   });
 
+  clientEvents = xQueueCreate(2 * PUSH_POLICY_MAX_CLIENTS, sizeof(ClientEvent));
   ws.onEvent(onEvent);
   server.addHandler(&ws);
   server.begin();
@@ -294,5 +372,8 @@ void loop() {
     }
   }
 
+  wsApplyClientEvents();
+  wsPushPendingFrames();
+
   ws.cleanupClients();
 }
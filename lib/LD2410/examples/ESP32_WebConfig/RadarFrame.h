@@ -0,0 +1,131 @@
+#pragma once
+
+/*
+ * Compact binary frame for pushing the radar data to the websocket clients.
+ * The header only depends on <stdint.h> so it can be used on the host as well.
+ *
+ * All multi byte values are little endian.
+ *
+ * Offset Size Field
+ *  0      1   protocol version (RADAR_FRAME_VERSION)
+ *  1      1   frame type (RADAR_FRAME_TYPE_CYCLIC)
+ *  2      2   sequence number
+ *  4      1   flags, bit 0: radar is in engineering mode
+ *  5      1   target state
+ *  6      2   moving target distance in cm
+ *  8      1   moving target energy 0-100 %
+ *  9      2   stationary target distance in cm
+ * 11      1   stationary target energy 0-100 %
+ * 12      2   detection distance in cm
+ * 14      1   engineering: maximum moving gate
+ * 15      1   engineering: maximum stationary gate
+ * 16      1   engineering: maximum moving energy
+ * 17      1   engineering: maximum stationary energy
+ * 18      9   engineering: moving energy per gate
+ * 27      9   engineering: stationary energy per gate
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RADAR_FRAME_VERSION     1
+#define RADAR_FRAME_TYPE_CYCLIC 0x01
+#define RADAR_FRAME_SIZE        36
+
+#define RADAR_FRAME_FLAG_ENGINEERING_MODE 0x01
+
+/**
+ * @brief Radar data carried by one binary frame
+ */
+struct RadarFrame {
+  uint16_t sequence;                  // incremented for every frame sent
+  bool radarInEngineeringMode;        // radar is in Engineering Mode
+  uint8_t targetState;                // target state
+  uint16_t movingTargetDistance;      // moving target distance in cm
+  uint8_t movingTargetEnergy;         // moving target energy value 0-100 %
+  uint16_t stationaryTargetDistance;  // stationary target distance in cm
+  uint8_t stationaryTargetEnergy;     // stationary target energy value 0-100 %
+  uint16_t detectionDistance;         // detection distance in cm
+  uint8_t maxMovingGate;              // maximum moving distance
+  uint8_t maxStationaryGate;          // maximum stationary distance
+  uint8_t maxMovingEnergy;            // maximum moving energy
+  uint8_t maxStationaryEnergy;        // maximum stationary energy
+  uint8_t movingEnergyGateN[9];       // moving energy per gate
+  uint8_t stationaryEnergyGateN[9];   // stationary energy per gate
+};
+
+/**
+ * @brief Encodes a radar frame into a buffer
+ *
+ * @param frame frame to encode
+ * @param buffer destination, at least RADAR_FRAME_SIZE bytes
+ * @param size size of the destination buffer
+ * @return size_t number of bytes written, 0 if the buffer is too small
+ */
+inline size_t radarFrameEncode(const RadarFrame &frame, uint8_t *buffer, size_t size) {
+  if (size < RADAR_FRAME_SIZE) {
+    return 0;
+  }
+
+  buffer[0]  = RADAR_FRAME_VERSION;
+  buffer[1]  = RADAR_FRAME_TYPE_CYCLIC;
+  buffer[2]  = uint8_t(frame.sequence);
+  buffer[3]  = uint8_t(frame.sequence >> 8);
+  buffer[4]  = frame.radarInEngineeringMode ? RADAR_FRAME_FLAG_ENGINEERING_MODE : 0x00;
+  buffer[5]  = frame.targetState;
+  buffer[6]  = uint8_t(frame.movingTargetDistance);
+  buffer[7]  = uint8_t(frame.movingTargetDistance >> 8);
+  buffer[8]  = frame.movingTargetEnergy;
+  buffer[9]  = uint8_t(frame.stationaryTargetDistance);
+  buffer[10] = uint8_t(frame.stationaryTargetDistance >> 8);
+  buffer[11] = frame.stationaryTargetEnergy;
+  buffer[12] = uint8_t(frame.detectionDistance);
+  buffer[13] = uint8_t(frame.detectionDistance >> 8);
+  buffer[14] = frame.maxMovingGate;
+  buffer[15] = frame.maxStationaryGate;
+  buffer[16] = frame.maxMovingEnergy;
+  buffer[17] = frame.maxStationaryEnergy;
+
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    buffer[18 + gate] = frame.movingEnergyGateN[gate];
+    buffer[27 + gate] = frame.stationaryEnergyGateN[gate];
+  }
+
+  return RADAR_FRAME_SIZE;
+}
+
+/**
+ * @brief Decodes a radar frame from a buffer
+ *
+ * @param buffer received data
+ * @param size size of the received data
+ * @param frame decoded frame
+ * @return true The frame was decoded
+ * @return false Unknown version, type or size
+ */
+inline bool radarFrameDecode(const uint8_t *buffer, size_t size, RadarFrame &frame) {
+  if (size < RADAR_FRAME_SIZE || buffer[0] != RADAR_FRAME_VERSION ||
+      buffer[1] != RADAR_FRAME_TYPE_CYCLIC) {
+    return false;
+  }
+
+  frame.sequence                 = uint16_t(buffer[2] | buffer[3] << 8);
+  frame.radarInEngineeringMode   = buffer[4] & RADAR_FRAME_FLAG_ENGINEERING_MODE;
+  frame.targetState              = buffer[5];
+  frame.movingTargetDistance     = uint16_t(buffer[6] | buffer[7] << 8);
+  frame.movingTargetEnergy       = buffer[8];
+  frame.stationaryTargetDistance = uint16_t(buffer[9] | buffer[10] << 8);
+  frame.stationaryTargetEnergy   = buffer[11];
+  frame.detectionDistance        = uint16_t(buffer[12] | buffer[13] << 8);
+  frame.maxMovingGate            = buffer[14];
+  frame.maxStationaryGate        = buffer[15];
+  frame.maxMovingEnergy          = buffer[16];
+  frame.maxStationaryEnergy      = buffer[17];
+
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    frame.movingEnergyGateN[gate]     = buffer[18 + gate];
+    frame.stationaryEnergyGateN[gate] = buffer[27 + gate];
+  }
+
+  return true;
+}
@@ -1,80 +1,329 @@
 #include "LD2410.h"
 
+// ACK timeout until enough round trips are measured in us
+#define ACK_TIMEOUT_DEFAULT 100000UL
+
+// measured round trips before the timeout is derived from them
+#define ACK_TIMEOUT_MIN_SAMPLES 4
+
+// limits of the derived ACK timeout in us
+#define ACK_TIMEOUT_MIN 10000UL
+#define ACK_TIMEOUT_MAX 1000000UL
+
+// safety margin added to twice the 99th percentile in us
+#define ACK_TIMEOUT_MARGIN 5000UL
+
 LD2410::LD2410(Stream &radarUart) {
   _radarUart = &radarUart;
+
+  memset(&_changeFilter, 0, sizeof(_changeFilter));
+  memset(&_frameStatistics, 0, sizeof(_frameStatistics));
+  _reportedTime = 0;
+
+#if LD2410_COMMANDS
+  _parameterValid = false;
+
+  memset(&_configSession, 0, sizeof(_configSession));
+  memset(_rttStatistics, 0, sizeof(_rttStatistics));
+  _retries = 1;
+  _receivedBytes = 0;
+  _lateRequest   = false;
+  _lateCommand   = ENABLE_CONFIG_MODE;
+  _lateStart     = 0;
+#endif
 }
 
 LD2410::~LD2410() {
 }
 
+#if LD2410_READ_COMMANDS
 bool LD2410::begin() {
   return readFirmwareVersion() && readParameter();
 }
+#endif
 
 bool LD2410::read() {
-  return (_parse() == 1);
+  if (_parse() != 1) {
+    return false;
+  }
+
+  _frameStatistics.receivedFrames++;
+
+  if (_changeFilter.enabled && !_frameChanged() &&
+      millis() - _reportedTime < _changeFilter.keepAliveInterval) {
+    return false;
+  }
+
+  _reportedCyclicData = _cyclicData;
+#if LD2410_ENGINEERING_MODE
+  _reportedEngineeringData = _engineeringData;
+#endif
+  _reportedTime = millis();
+
+  _frameStatistics.deliveredFrames++;
+  return true;
+}
+
+void LD2410::setChangeOnly(bool enable, uint16_t keepAliveInterval) {
+  _changeFilter.enabled           = enable;
+  _changeFilter.keepAliveInterval = keepAliveInterval;
+
+  // report the next frame in any case
+  _reportedCyclicData.targetState = (TargetState)0xFF;
+}
+
+void LD2410::setDeadband(uint16_t distance, uint8_t energy) {
+  _changeFilter.distanceDeadband = distance;
+  _changeFilter.energyDeadband   = energy;
+}
+
+#if LD2410_ENGINEERING_MODE
+void LD2410::setGateDeadband(uint8_t gate, uint8_t moving, uint8_t stationary) {
+  if (gate > 8) {
+    return;
+  }
+
+  _changeFilter.movingGateDeadband[gate]     = moving;
+  _changeFilter.stationaryGateDeadband[gate] = stationary;
+}
+
+#endif
+
+// true if the difference between a and b is larger than the deadband
+static bool outsideDeadband(uint16_t a, uint16_t b, uint16_t deadband) {
+  return (a > b ? a - b : b - a) > deadband;
+}
+
+bool LD2410::_frameChanged() {
+  const CyclicData &last = _reportedCyclicData;
+
+  if (_cyclicData.targetState != last.targetState ||
+      _cyclicData.radarInEngineeringMode != last.radarInEngineeringMode) {
+    return true;
+  }
+
+  const uint16_t distance = _changeFilter.distanceDeadband;
+  const uint8_t energy    = _changeFilter.energyDeadband;
+
+  if (outsideDeadband(_cyclicData.movingTargetDistance, last.movingTargetDistance, distance) ||
+      outsideDeadband(_cyclicData.stationaryTargetDistance, last.stationaryTargetDistance, distance) ||
+      outsideDeadband(_cyclicData.detectionDistance, last.detectionDistance, distance) ||
+      outsideDeadband(_cyclicData.movingTargetEnergy, last.movingTargetEnergy, energy) ||
+      outsideDeadband(_cyclicData.stationaryTargetEnergy, last.stationaryTargetEnergy, energy)) {
+    return true;
+  }
+
+#if LD2410_ENGINEERING_MODE
+  if (!_cyclicData.radarInEngineeringMode) {
+    return false;
+  }
+
+  const EngineeringData &lastEng = _reportedEngineeringData;
+
+  if (_engineeringData.maxMovingGate != lastEng.maxMovingGate ||
+      _engineeringData.maxStationaryGate != lastEng.maxStationaryGate) {
+    return true;
+  }
+
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    if (outsideDeadband(_engineeringData.movingEnergyGateN[gate], lastEng.movingEnergyGateN[gate],
+                        _changeFilter.movingGateDeadband[gate]) ||
+        outsideDeadband(_engineeringData.stationaryEnergyGateN[gate], lastEng.stationaryEnergyGateN[gate],
+                        _changeFilter.stationaryGateDeadband[gate])) {
+      return true;
+    }
+  }
+#endif
+
+  return false;
 }
 
-bool LD2410::_sendCommand(RadarCommand cmd, const uint8_t *data, size_t dataSize) {
-  if (_enableConfigMode()) {
-    if (_sendRequestToRadar(cmd, data, dataSize)) {
-      // radar restarted so we don´t need to disable config mode
-      if (cmd == RESTART) {
-        return true;
-      }
+#if LD2410_COMMANDS
+bool LD2410::_sendCommand(RadarCommand cmd, const uint8_t *frame, size_t frameSize) {
+  uint32_t receivedBytes = _receivedBytes;
+
+  // fail fast if the radar doesn't enter the config mode
+  if (!_enableConfigMode()) {
+    _abortConfigMode(receivedBytes);
+    return false;
+  }
 
-      return (_disableConfigMode());
+  if (_sendRequestToRadar(cmd, frame, frameSize)) {
+    // radar restarted so we don´t need to disable config mode
+    if (cmd == RESTART) {
+      _configSession.active = false;
+      return true;
     }
 
-    // Disable config mode even if the command has failed
-    _disableConfigMode();
+    return (_disableConfigMode());
   }
 
+  // Disable config mode even if the command has failed
+  _disableConfigMode();
   return false;
 }
 
-bool LD2410::_sendRequestToRadar(RadarCommand cmd, const uint8_t *data, size_t dataSize) {
-  // send command Header
-  _radarUart->write(_commandHeader, sizeof(_commandHeader));
+bool LD2410::_sendRequestToRadar(RadarCommand cmd, const uint8_t *frame, size_t frameSize) {
+  RttStatistics &stats  = _rttStatistics[_commandIndex(cmd)];
+  unsigned long timeout = _ackTimeout(stats);
+  unsigned long start   = micros();
+
+  uint8_t retries       = _isRepeatable(cmd) ? _retries : 0;
 
-  // send frame data length
-  _radarUart->write(sizeof(cmd) + dataSize);
-  _radarUart->write(uint8_t(0x00));
+  stats.requests++;
 
-  // send command
-  _radarUart->write(highByte(cmd));
-  _radarUart->write(lowByte(cmd));
+  for (uint8_t attempt = 0; attempt <= retries; attempt++) {
+    if (attempt) {
+      stats.retries++;
+      timeout *= 2;  // backoff
+    }
 
-  // send frame data
-  _radarUart->write(data, dataSize);
+    _writeRequest(frame, frameSize);
 
-  // send command tail (mfr)
-  _radarUart->write(_commandTail, sizeof(_commandTail));
+    AckResult res = _waitForAck(cmd, 1, timeout);
+    if (res != ACK_TIMEOUT) {
+      // measured from the first attempt, a late ACK counts as slow round trip
+      _recordRtt(stats, micros() - start);
+      return res == ACK_OK;
+    }
+
+    stats.timeouts++;
+  }
+
+  _lateRequest = true;
+  _lateCommand = cmd;
+  _lateStart   = start;
+  return false;
+}
+
+void LD2410::_writeRequest(const uint8_t *frame, size_t frameSize) {
+  // send the whole frame at once
+  _radarUart->write(frame, frameSize);
 
   // wait send is completed
   _radarUart->flush();
+}
 
-  unsigned long timeout = millis();
-  while (millis() - timeout < 100) {
+LD2410::AckResult LD2410::_waitForAck(RadarCommand cmd, uint8_t count, unsigned long timeout) {
+  unsigned long start = micros();
+  while (count && micros() - start < timeout) {
     uint16_t res = _parse();
     // command was successfully executed
     if (res == cmd) {
-      return true;
+      count--;
+      start = micros();
       // command has failed
     } else if (res == (cmd + 1)) {
-      return false;
+      return ACK_FAILED;
     }
   }
 
-  return false;
+  return count ? ACK_TIMEOUT : ACK_OK;
+}
+
+uint8_t LD2410::_commandIndex(RadarCommand cmd) const {
+  switch (cmd) {
+    case ENABLE_CONFIG_MODE:
+      return 0;
+    case DISABLE_CONFIG_MODE:
+      return 1;
+    case SET_MAX_DIST_AND_DUR:
+      return 2;
+    case READ_PARAMETER:
+      return 3;
+    case ENABLE_ENGINEERING_MODE:
+      return 4;
+    case DISABLE_ENGINEERING_MODE:
+      return 5;
+    case SET_GATE_SENS_CONFIG:
+      return 6;
+    case READ_FIRMWARE_VERSION:
+      return 7;
+    case SET_BAUDRATE:
+      return 8;
+    case FACTORY_RESET:
+      return 9;
+    default:
+      return 10;  // RESTART
+  }
 }
 
+bool LD2410::_isRepeatable(RadarCommand cmd) const {
+  return cmd != RESTART && cmd != FACTORY_RESET && cmd != SET_BAUDRATE &&
+         cmd != ENABLE_CONFIG_MODE && cmd != DISABLE_CONFIG_MODE;
+}
+
+unsigned long LD2410::_ackTimeout(const RttStatistics &stats) const {
+  if (stats.samples < ACK_TIMEOUT_MIN_SAMPLES) {
+    return ACK_TIMEOUT_DEFAULT;
+  }
+
+  unsigned long timeout = 2 * stats.p99Rtt + ACK_TIMEOUT_MARGIN;
+  if (timeout < ACK_TIMEOUT_MIN) {
+    return ACK_TIMEOUT_MIN;
+  }
+  return timeout > ACK_TIMEOUT_MAX ? ACK_TIMEOUT_MAX : timeout;
+}
+
+void LD2410::_recordRtt(RttStatistics &stats, uint32_t rtt) {
+  if (stats.samples == 0) {
+    stats.minRtt = stats.maxRtt = stats.avgRtt = stats.p99Rtt = rtt;
+  } else {
+    if (rtt < stats.minRtt) {
+      stats.minRtt = rtt;
+    }
+    if (rtt > stats.maxRtt) {
+      stats.maxRtt = rtt;
+    }
+
+    // EWMA with alpha 1/8
+    stats.avgRtt = stats.avgRtt - (stats.avgRtt >> 3) + (rtt >> 3);
+
+    // streaming quantile estimate: step up fast, step down 99 times slower
+    uint32_t step = stats.avgRtt >> 2;
+    if (step == 0) {
+      step = 1;
+    }
+    if (rtt > stats.p99Rtt) {
+      stats.p99Rtt = (rtt - stats.p99Rtt < step) ? rtt : stats.p99Rtt + step;
+    } else {
+      uint32_t down = step / 99 + 1;
+      stats.p99Rtt  = (stats.p99Rtt - rtt < down) ? rtt : stats.p99Rtt - down;
+    }
+  }
+  stats.samples++;
+}
+
+const LD2410::RttStatistics &LD2410::rttStatistics(RadarCommand cmd) const {
+  return _rttStatistics[_commandIndex(cmd)];
+}
+
+void LD2410::setRetries(uint8_t retries) {
+  _retries = retries;
+}
+
+#if LD2410_CONFIG_COMMANDS
+uint8_t LD2410::_pipelineDepth(size_t frameSize) {
+  size_t depth = _configSession.bufferSize / frameSize;
+
+  if (depth < 1) {
+    return 1;
+  }
+  return depth > 9 ? 9 : depth;
+}
+
+#endif
+
 bool LD2410::_sendCommand(RadarCommand cmd) {
-  return _sendCommand(cmd, NULL, 0);
+  LD2410EmptyCommand frame(cmd);
+  return _sendCommand(cmd, frame.data(), frame.size());
 }
 
+#endif
+
 uint16_t LD2410::_charToUint(char c1, char c2) {
-  return (uint16_t)(c1 | c2 << 8);
+  // char is signed on some platforms, bytes over 0x7F must not sign extend
+  return (uint16_t)((uint8_t)c1 | (uint8_t)c2 << 8);
 }
 
 uint16_t LD2410::_parse() {
@@ -85,6 +334,9 @@ uint16_t LD2410::_parse() {
 
   while (_radarUart->available()) {
     uint8_t readChar = _radarUart->read();
+#if LD2410_COMMANDS
+    _receivedBytes++;
+#endif
 
     switch (parserState) {
       case FIND_FRAME_HEADER:
@@ -100,12 +352,14 @@ uint16_t LD2410::_parse() {
           receivedBytes = 0;
         }
 
+#if LD2410_COMMANDS
         // Check for command header
         if (!memcmp(dataBuffer, _commandHeader, sizeof(_commandHeader))) {
           dataPayload   = false;
           parserState   = RECEIVE_DATA_LENGTH;
           receivedBytes = 0;
         }
+#endif
         break;
 
       case RECEIVE_DATA_LENGTH:
@@ -137,6 +391,10 @@ uint16_t LD2410::_parse() {
               return 0;
             }
 
+#if LD2410_ENGINEERING_MODE
+            bool wasEngineeringMode = _cyclicData.radarInEngineeringMode;
+#endif
+
             // Engineering mode active
             _cyclicData.radarInEngineeringMode = dataBuffer[0] == 0x01;
 
@@ -165,6 +423,7 @@ uint16_t LD2410::_parse() {
             _cyclicData.detectionDistance = _charToUint(dataBuffer[9], dataBuffer[10]);
 
             if (_cyclicData.radarInEngineeringMode) {
+#if LD2410_ENGINEERING_MODE
               // Maximum distance gate
               _engineeringData.maxMovingGate     = dataBuffer[11];
               _engineeringData.maxStationaryGate = dataBuffer[12];
@@ -182,6 +441,7 @@ uint16_t LD2410::_parse() {
               // max energy per gate
               _engineeringData.maxMovingEnergy     = dataBuffer[31];
               _engineeringData.maxStationaryEnergy = dataBuffer[32];
+#endif
 
               // 0x55 cyclicData tail and check (0x00)
               if (dataBuffer[33] == 0x55 && dataBuffer[34] == 0x00) {
@@ -190,7 +450,12 @@ uint16_t LD2410::_parse() {
               }
 
             } else {
-              memset(&_engineeringData, 0, sizeof(_engineeringData));
+#if LD2410_ENGINEERING_MODE
+              // clear the engineering data once after leaving the engineering mode
+              if (wasEngineeringMode) {
+                memset(&_engineeringData, 0, sizeof(_engineeringData));
+              }
+#endif
 
               // 0x55 cyclicData tail and check (0x00)
               if (dataBuffer[11] == 0x55 && dataBuffer[12] == 0x00) {
@@ -202,6 +467,7 @@ uint16_t LD2410::_parse() {
             return 0;
 
           } else {  // Command data
+#if LD2410_COMMANDS
 
             // Tail not found
             if (memcmp(&dataBuffer[dataLength], _commandTail, sizeof(_commandTail))) {
@@ -214,7 +480,14 @@ uint16_t LD2410::_parse() {
 
             bool fail = _charToUint(dataBuffer[2], dataBuffer[3]) != 0;
 
+            // late ACK of a timed out request, also from read(): the timeout learns from it
+            if (_lateRequest && cmd == _lateCommand) {
+              _lateRequest = false;
+              _recordRtt(_rttStatistics[_commandIndex(_lateCommand)], micros() - _lateStart);
+            }
+
             switch (cmd) {
+#if LD2410_READ_COMMANDS
               case READ_PARAMETER:
                 // parameter header
                 if (dataBuffer[4] != 0xAA) {
@@ -234,6 +507,7 @@ uint16_t LD2410::_parse() {
                 }
 
                 _parameter.detectionTime = _charToUint(dataBuffer[26], dataBuffer[27]);
+                _parameterValid          = !fail;
                 break;
               case READ_FIRMWARE_VERSION:
 
@@ -244,14 +518,22 @@ uint16_t LD2410::_parse() {
                     dataBuffer[10] << 16 | dataBuffer[11] << 24);
 
                 break;
+#endif
+
+              case ENABLE_CONFIG_MODE:
+                if (!fail) {
+                  _configSession.protocolVersion = _charToUint(dataBuffer[4], dataBuffer[5]);
+                  _configSession.bufferSize      = _charToUint(dataBuffer[6], dataBuffer[7]);
+                }
+                break;
 
               default:
-                // TODO Protocol version, radar buffer size...
                 break;
             }
 
             parserState = FIND_FRAME_HEADER;
             return cmd + fail;
+#endif
           }
         }
 
@@ -261,54 +543,79 @@ uint16_t LD2410::_parse() {
   return 0;  // no data
 }
 
+#if LD2410_COMMANDS
 bool LD2410::_enableConfigMode() {
-  uint8_t data[2] = {0x01, 0x00};
-  _sendRequestToRadar(ENABLE_CONFIG_MODE, data, sizeof(data));
-  return true; // TODO
+  LD2410ValueCommand frame(ENABLE_CONFIG_MODE);
+  frame.add16(0x0001);
+
+  _configSession.active = _sendRequestToRadar(ENABLE_CONFIG_MODE, frame.data(), frame.size());
+  return _configSession.active;
 }
 
-bool LD2410::_disableConfigMode() {
-  _sendRequestToRadar(DISABLE_CONFIG_MODE, NULL, 0);  
-  return true; // TODO
+void LD2410::_abortConfigMode(uint32_t receivedBytes) {
+  // nothing came back, the radar is not connected or not powered
+  if (_receivedBytes == receivedBytes) {
+    return;
+  }
+
+  // the ACK may be lost or late with the radar in config mode, it would send no data frames
+  _disableConfigMode();
 }
 
-bool LD2410::setMaxDistAndDur(uint8_t maxMovingRange, uint8_t maxStationaryRange, uint16_t duration) {
-  uint8_t data[18]{
+bool LD2410::_disableConfigMode() {
+  LD2410EmptyCommand frame(DISABLE_CONFIG_MODE);
 
-      // maxMovingRange Command word 0
-      0x00,  // low  byte command word 0
-      0x00,  // high byte command word 0
+  if (!_sendRequestToRadar(DISABLE_CONFIG_MODE, frame.data(), frame.size())) {
+    return false;
+  }
 
-      maxMovingRange,
-      0x00,
-      0x00,  // fill byte
-      0x00,  // fill byte
+  _configSession.active = false;
+  return true;
+}
 
-      // maxStationaryRange command word 1
-      0x01,  // low  byte command word 1
-      0x00,  // high byte command word 1
+#endif
 
-      maxStationaryRange,
-      0x00,
-      0x00,  // fill byte
-      0x00,  // fill byte
+#if LD2410_CONFIG_COMMANDS
+bool LD2410::setMaxDistAndDur(uint8_t maxMovingRange, uint8_t maxStationaryRange, uint16_t duration) {
+  LD2410ParameterCommand frame(SET_MAX_DIST_AND_DUR);
+  frame.addParameter(0x0000, maxMovingRange)
+      .addParameter(0x0001, maxStationaryRange)
+      .addParameter(0x0002, duration);
 
-      // duration Command word 2
-      0x02,  // low  byte command word 2
-      0x00,  // high byte command word 2
+  // a failed or timed out command may still have been applied by the radar
+  bool wasValid   = _parameterValid;
+  _parameterValid = false;
 
-      lowByte(duration), highByte(duration),
-      0x00,  // fill byte
-      0x00   // fill byte
-  };
+  if (!_sendCommand(SET_MAX_DIST_AND_DUR, frame.data(), frame.size())) {
+    return false;
+  }
 
-  return _sendCommand(SET_MAX_DIST_AND_DUR, data, sizeof(data));
+  // acknowledged by the radar, keep the cached parameters up to date
+  _parameter.maxMovingGate     = maxMovingRange;
+  _parameter.maxStationaryGate = maxStationaryRange;
+  _parameter.detectionTime     = duration;
+  _parameterValid              = wasValid;
+  return true;
 }
 
+#endif
+
+#if LD2410_READ_COMMANDS
 bool LD2410::readParameter() {
   return _sendCommand(READ_PARAMETER);
 }
 
+bool LD2410::updateParameter() {
+  return _parameterValid || readParameter();
+}
+
+bool LD2410::isParameterValid() const {
+  return _parameterValid;
+}
+
+#endif
+
+#if LD2410_CONFIG_COMMANDS
 bool LD2410::enableEngMode(bool enable) {
   if (enable) {
     return _sendCommand(ENABLE_ENGINEERING_MODE);
@@ -316,55 +623,98 @@ bool LD2410::enableEngMode(bool enable) {
   return _sendCommand(DISABLE_ENGINEERING_MODE);
 }
 
+LD2410ParameterCommand LD2410::_gateSensConfFrame(uint8_t gate, uint8_t movingSensitivity, uint8_t stationarySensitivity) {
+  LD2410ParameterCommand frame(SET_GATE_SENS_CONFIG);
+  frame.addParameter(0x0000, gate)
+      .addParameter(0x0001, movingSensitivity)
+      .addParameter(0x0002, stationarySensitivity);
+  return frame;
+}
+
 bool LD2410::setGateSensConf(uint8_t gate, uint8_t movingSensitivity, uint8_t stationarySensitivity) {
-  uint8_t data[18] = {
-      // gate Command word 0
-      0x00,  // low  byte command word 0
-      0x00,  // high byte command word 0
+  LD2410ParameterCommand frame = _gateSensConfFrame(gate, movingSensitivity, stationarySensitivity);
 
-      gate,  // gate
-      0x00,  // fill byte
-      0x00,  // fill byte
-      0x00,  // fill byte
+  // a failed or timed out command may still have been applied by the radar
+  bool wasValid   = _parameterValid;
+  _parameterValid = false;
+
+  if (!_sendCommand(SET_GATE_SENS_CONFIG, frame.data(), frame.size())) {
+    return false;
+  }
 
-      // moving sensitivity command word 1
-      0x01,  // low  byte command word 1
-      0x00,  // high byte command word 1
+  // acknowledged by the radar, keep the cached parameters up to date
+  if (gate <= 8) {
+    _parameter.movingSensitivity[gate]     = movingSensitivity;
+    _parameter.stationarySensitivity[gate] = stationarySensitivity;
+  }
+  _parameterValid = wasValid;
+  return true;
+}
 
-      movingSensitivity,  // moving sensitivity
-      0x00,               // fill byte
-      0x00,               // fill byte
-      0x00,               // fill byte
+bool LD2410::setGateSensConf(const uint8_t movingSensitivity[9], const uint8_t stationarySensitivity[9]) {
+  // a failed or timed out command may still have been applied by the radar
+  bool wasValid   = _parameterValid;
+  _parameterValid = false;
 
-      // stationary sensitivity command word 2
-      0x02,  // low  byte command word 2
-      0x00,  // high byte command word 2
+  uint32_t receivedBytes = _receivedBytes;
+  if (!_enableConfigMode()) {
+    _abortConfigMode(receivedBytes);
+    return false;
+  }
 
-      stationarySensitivity,  // stationary sensitivity
-      0x00,                   // fill byte
-      0x00,                   // fill byte
-      0x00                    // fill byte
-  };
+  const uint8_t depth = _pipelineDepth(LD2410ParameterCommand::SIZE);
+  bool result         = true;
 
-  return _sendCommand(SET_GATE_SENS_CONFIG, data, sizeof(data));
+  for (uint8_t gate = 0; gate <= 8 && result;) {
+    // send as many commands as the radar can buffer, then collect the ACKs
+    uint8_t sent = 0;
+    for (; sent < depth && gate + sent <= 8; sent++) {
+      LD2410ParameterCommand frame =
+          _gateSensConfFrame(gate + sent, movingSensitivity[gate + sent], stationarySensitivity[gate + sent]);
+      _writeRequest(frame.data(), frame.size());
+    }
+
+    const RttStatistics &stats = _rttStatistics[_commandIndex(SET_GATE_SENS_CONFIG)];
+    result                     = _waitForAck(SET_GATE_SENS_CONFIG, sent, _ackTimeout(stats)) == ACK_OK;
+
+    // acknowledged by the radar, keep the cached parameters up to date
+    for (; result && sent; sent--, gate++) {
+      _parameter.movingSensitivity[gate]     = movingSensitivity[gate];
+      _parameter.stationarySensitivity[gate] = stationarySensitivity[gate];
+    }
+  }
+
+  // Disable config mode even if the command has failed
+  result = _disableConfigMode() && result;
+
+  // every gate acknowledged, the cached parameters are up to date
+  _parameterValid = wasValid && result;
+  return result;
 }
 
 bool LD2410::setBaudRate(BaudRateIndex baudRate) {
-  uint8_t data[2] = {
-      baudRate,
-      0x00};
+  LD2410ValueCommand frame(SET_BAUDRATE);
+  frame.add16(baudRate);
 
-  return _sendCommand(SET_BAUDRATE, data, sizeof(data));
+  return _sendCommand(SET_BAUDRATE, frame.data(), frame.size());
 }
 
 bool LD2410::factoryReset() {
+  // the radar restores its default parameters, maybe even without an ACK
+  _parameterValid = false;
   return _sendCommand(FACTORY_RESET);
 }
 
 bool LD2410::restart() {
+  // restored default parameters take effect after the restart
+  _parameterValid = false;
   return _sendCommand(RESTART);
 }
 
+#endif
+
+#if LD2410_READ_COMMANDS
 bool LD2410::readFirmwareVersion() {
   return _sendCommand(READ_FIRMWARE_VERSION);
 }
+#endif
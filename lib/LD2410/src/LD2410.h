@@ -2,6 +2,12 @@
 
 #include <Arduino.h>
 
+#include "LD2410Config.h"
+
+#if LD2410_COMMANDS
+#include "LD2410Command.h"
+#endif
+
 /**
  * @brief Radar Target State
  */
@@ -27,6 +33,27 @@ enum BaudRateIndex : uint8_t {
 };
 
 class LD2410 {
+ public:
+  /**
+   * @brief List of the radar commands
+   */
+  enum RadarCommand : uint16_t {
+    ENABLE_CONFIG_MODE       = 0xFF00,  // enable configuration mode
+    DISABLE_CONFIG_MODE      = 0xFE00,  // disable configuration mode
+    SET_MAX_DIST_AND_DUR     = 0x6000,  // set the maximum Distance Gate and Unmanned Duration Parameter
+    READ_PARAMETER           = 0x6100,  // read the parameters from the radar
+    ENABLE_ENGINEERING_MODE  = 0x6200,  // enable engineering mode of the radar
+    DISABLE_ENGINEERING_MODE = 0x6300,  // disable engineering mode
+    SET_GATE_SENS_CONFIG     = 0x6400,  // set sensitivity 0-100% for moving and stationary gates
+    READ_FIRMWARE_VERSION    = 0xA000,  // read  the firmware version
+    SET_BAUDRATE             = 0xA100,  // set serial baud rate
+    FACTORY_RESET            = 0xA200,  // Factory Reset
+    RESTART                  = 0xA300,  // Restart the radar
+  };
+
+  // number of radar commands
+  static const uint8_t RADAR_COMMAND_COUNT = 11;
+
  private:
   /**
    * @brief Stucture of Parameters from Radar
@@ -65,6 +92,60 @@ class LD2410 {
     uint8_t stationaryEnergyGateN[9];  // stationary energy per gate
   };
 
+  /**
+   * @brief Deadbands for the change only frame delivery of read()
+   */
+  struct ChangeFilter {
+    bool enabled;                       // read() reports only changed frames
+    uint16_t distanceDeadband;          // distance change in cm to report a frame
+    uint8_t energyDeadband;             // target energy change in % to report a frame
+#if LD2410_ENGINEERING_MODE
+    uint8_t movingGateDeadband[9];      // moving energy change per gate in %
+    uint8_t stationaryGateDeadband[9];  // stationary energy change per gate in %
+#endif
+    uint16_t keepAliveInterval;         // report a frame at least every n ms
+  };
+
+  /**
+   * @brief Frame counters of read()
+   */
+  struct FrameStatistics {
+    uint32_t receivedFrames;   // complete data frames received from the radar
+    uint32_t deliveredFrames;  // frames reported as new by read()
+  };
+
+  /**
+   * @brief Round trip statistics of one radar command
+   */
+  struct RttStatistics {
+    uint32_t requests;  // requests sent, without retries
+    uint32_t retries;   // requests repeated after a timeout
+    uint32_t timeouts;  // attempts without ACK
+    uint32_t samples;   // measured round trips
+    uint32_t minRtt;    // minimum round trip time in us
+    uint32_t avgRtt;    // average (EWMA 1/8) round trip time in us
+    uint32_t p99Rtt;    // estimated 99th percentile of the round trip time in us
+    uint32_t maxRtt;    // maximum round trip time in us
+  };
+
+  /**
+   * @brief Result of waiting for command ACKs
+   */
+  enum AckResult : uint8_t {
+    ACK_OK,
+    ACK_FAILED,
+    ACK_TIMEOUT
+  };
+
+  /**
+   * @brief Configuration mode session, filled from the enable config ACK
+   */
+  struct ConfigSession {
+    bool active;               // radar is in configuration mode
+    uint16_t protocolVersion;  // protocol version reported by the radar
+    uint16_t bufferSize;       // radar receive buffer size in bytes
+  };
+
   /**
    * @brief Radars firmware version
    */
@@ -74,23 +155,6 @@ class LD2410 {
     uint32_t bugFixVersion;  // bug fix version of the radar firmware
   };
 
-  /**
-   * @brief List of the radar commands
-   */
-  enum RadarCommand : uint16_t {
-    ENABLE_CONFIG_MODE       = 0xFF00,  // enable configuration mode
-    DISABLE_CONFIG_MODE      = 0xFE00,  // disable configuration mode
-    SET_MAX_DIST_AND_DUR     = 0x6000,  // set the maximum Distance Gate and Unmanned Duration Parameter
-    READ_PARAMETER           = 0x6100,  // read the parameters from the radar
-    ENABLE_ENGINEERING_MODE  = 0x6200,  // enable engineering mode of the radar
-    DISABLE_ENGINEERING_MODE = 0x6300,  // disable engineering mode
-    SET_GATE_SENS_CONFIG     = 0x6400,  // set sensitivity 0-100% for moving and stationary gates
-    READ_FIRMWARE_VERSION    = 0xA000,  // read  the firmware version
-    SET_BAUDRATE             = 0xA100,  // set serial baud rate
-    FACTORY_RESET            = 0xA200,  // Factory Reset
-    RESTART                  = 0xA300,  // Restart the radar
-  };
-
   /**
    * @brief Parser State
    */
@@ -100,17 +164,18 @@ class LD2410 {
     RECEIVE_DATA
   };
 
+#if LD2410_COMMANDS
   /**
-   * @brief Helper function to send a command to the radar with data
+   * @brief Helper function to send a command frame to the radar
    *
    * @param cmd command to send
-   * @param data data/payload to send
-   * @param dataSize size of the data
+   * @param frame encoded command frame, see LD2410CommandFrame
+   * @param frameSize size of the frame
    * @return true Command executed successfully
    * @return false Command executed with errors
    */
 
-  bool _sendCommand(RadarCommand cmd, const uint8_t* data, size_t dataSize);
+  bool _sendCommand(RadarCommand cmd, const uint8_t* frame, size_t frameSize);
 
   /**
    * @brief Helper function to send and command to the radar without data
@@ -122,15 +187,94 @@ class LD2410 {
   bool _sendCommand(RadarCommand cmd);
 
   /**
-   * @brief Funtion to send the data to the radar
+   * @brief Funtion to send a command frame to the radar
    * @param cmd request command to send
-   * @param data data to send
-   * @param dataSize size of the data
+   * @param frame encoded command frame
+   * @param frameSize size of the frame
    * @return true Request was executed successfully
    * @return false Request executed with errors
    */
-  bool _sendRequestToRadar(RadarCommand cmd, const uint8_t* data, size_t dataSize);
+  bool _sendRequestToRadar(RadarCommand cmd, const uint8_t* frame, size_t frameSize);
+
+  /**
+   * @brief Writes a command frame to the radar with one write(), without
+   * waiting for the ACK
+   *
+   * @param frame encoded command frame
+   * @param frameSize size of the frame
+   */
+  void _writeRequest(const uint8_t* frame, size_t frameSize);
+
+  /**
+   * @brief Waits for the ACKs of pipelined commands
+   *
+   * @param cmd command which was sent
+   * @param count number of ACKs to wait for
+   * @param timeout time to wait for every ACK in us
+   * @return AckResult ACK_OK if all commands were acknowledged successfully
+   */
+  AckResult _waitForAck(RadarCommand cmd, uint8_t count, unsigned long timeout);
+
+  /**
+   * @brief Index of a command in the round trip statistics
+   */
+  uint8_t _commandIndex(RadarCommand cmd) const;
+
+  /**
+   * @brief Check if a command may be sent again after an ACK timeout
+   *
+   * Restart, factory reset and baud rate change have probably been
+   * executed even if the ACK got lost, they are never repeated. Neither
+   * are the config mode commands, a radar which doesn't answer them is
+   * not there, and a late ACK still counts as round trip.
+   */
+  bool _isRepeatable(RadarCommand cmd) const;
+
+  /**
+   * @brief Leaves the config mode after a failed enable
+   *
+   * The radar may be in config mode with the ACK lost. One disable is sent,
+   * unless no byte came from the radar since the enable was sent.
+   *
+   * @param receivedBytes _receivedBytes before the enable
+   */
+  void _abortConfigMode(uint32_t receivedBytes);
+
+  /**
+   * @brief ACK timeout derived from the measured round trip times
+   *
+   * @param stats round trip statistics of the command
+   * @return unsigned long timeout in us
+   */
+  unsigned long _ackTimeout(const RttStatistics& stats) const;
 
+  /**
+   * @brief Adds a measured round trip time to the statistics
+   */
+  void _recordRtt(RttStatistics& stats, uint32_t rtt);
+
+#if LD2410_CONFIG_COMMANDS
+  /**
+   * @brief Number of command frames the radar can buffer in the current
+   * config session, at least one.
+   *
+   * @param frameSize size of one command frame
+   * @return uint8_t number of commands which can be sent without waiting for the ACK
+   */
+  uint8_t _pipelineDepth(size_t frameSize);
+
+  /**
+   * @brief Encodes a set gate sensitivity command
+   *
+   * @param gate Distance Gate 0-8
+   * @param movingSensitivity Moving sensitivity 0-100%
+   * @param stationarySensitivity Stationary sensitivity 0-100%
+   * @return LD2410ParameterCommand the command frame
+   */
+  LD2410ParameterCommand _gateSensConfFrame(uint8_t gate, uint8_t movingSensitivity, uint8_t stationarySensitivity);
+#endif
+
+#endif
   /**
    * @brief Helper function to convert tow char to an uint16_t
    *
@@ -147,6 +291,7 @@ class LD2410 {
    */
   uint16_t _parse();
 
+#if LD2410_COMMANDS
   /**
    * @brief Enables the configuration mode on the LD2410
    *
@@ -162,18 +307,70 @@ class LD2410 {
    * @return false Failed to disable the configuration mode
    */
   bool _disableConfigMode();
+#endif
 
+  /**
+   * @brief Compares the received frame with the last reported frame
+   *
+   * @return true The frame differs by more than the configured deadbands
+   * @return false The frame is within the deadbands of the last reported frame
+   */
+  bool _frameChanged();
+
+#if LD2410_READ_COMMANDS
   // readed firmware version of the radar
   FirmwareVersion _firmwareVersion;
+#endif
 
+#if LD2410_COMMANDS
   // parameters from the radar
   Parameter _parameter;     
 
+  // current configuration mode session
+  ConfigSession _configSession;
+
+  // round trip statistics per command
+  RttStatistics _rttStatistics[RADAR_COMMAND_COUNT];
+
+  // number of retries after an ACK timeout
+  uint8_t _retries;
+
+  // bytes read from the radar, tells a silent radar from a lost ACK
+  uint32_t _receivedBytes;
+
+  // last request without ACK in time, its late ACK still counts as round trip
+  bool _lateRequest;
+  RadarCommand _lateCommand;
+  unsigned long _lateStart;
+
+  // the cached parameters match the radars configuration
+  bool _parameterValid;
+#endif
+
   // cyclic data of from the radar         
   CyclicData _cyclicData; 
 
+#if LD2410_ENGINEERING_MODE
   // engineering data from the radar          
   EngineeringData _engineeringData;  
+#endif
+
+  // deadbands for the change only frame delivery
+  ChangeFilter _changeFilter;
+
+  // last cyclic data reported by read()
+  CyclicData _reportedCyclicData;
+
+#if LD2410_ENGINEERING_MODE
+  // last engineering data reported by read()
+  EngineeringData _reportedEngineeringData;
+#endif
+
+  // time of the last frame reported by read()
+  unsigned long _reportedTime;
+
+  // frame counters of read()
+  FrameStatistics _frameStatistics;
 
   // Data Header
   const uint8_t _dataHeader[4] = {0XF4, 0xF3, 0XF2, 0xF1};
@@ -181,11 +378,13 @@ class LD2410 {
   // Data tail
   const uint8_t _dataTail[4] = {0xF8, 0xF7, 0xF6, 0xF5};
 
+#if LD2410_COMMANDS
   // Command Header
   const uint8_t _commandHeader[4] = {0XFD, 0xFC, 0XFB, 0xFA};
 
   // Command tail
   const uint8_t _commandTail[4] = {0x04, 0x03, 0x02, 0x01};
+#endif
 
   // radars uart port
   Stream* _radarUart;
@@ -204,6 +403,7 @@ class LD2410 {
    */
   ~LD2410();
 
+#if LD2410_READ_COMMANDS
   /**
    * @brief Reads the firmware version and the parameters from the radars
    *
@@ -211,6 +411,7 @@ class LD2410 {
    * @return false failed to receive the firmware version or the parameters
    */
   bool begin();
+#endif
 
   /**
    * @brief Check if received data from the radar (needs to be called in loop)
@@ -220,6 +421,55 @@ class LD2410 {
    */
   bool read();
 
+  /**
+   * @brief Enable or disable the change only frame delivery. If enabled read()
+   * only returns true if the target state changed, a value moved beyond its
+   * deadband or the keep alive interval has expired.
+   *
+   * @param enable If true only changed frames are reported
+   * @param keepAliveInterval report a frame at least every n ms
+   */
+  void setChangeOnly(bool enable, uint16_t keepAliveInterval = 1000);
+
+  /**
+   * @brief Set the deadbands for the target distances and energies
+   *
+   * @param distance distance change in cm
+   * @param energy energy change in %
+   */
+  void setDeadband(uint16_t distance, uint8_t energy);
+
+#if LD2410_ENGINEERING_MODE
+  /**
+   * @brief Set the deadbands for the engineering energies of one gate
+   *
+   * @param gate Distance Gate 0-8
+   * @param moving moving energy change in %
+   * @param stationary stationary energy change in %
+   */
+  void setGateDeadband(uint8_t gate, uint8_t moving, uint8_t stationary);
+#endif
+
+#if LD2410_COMMANDS
+  /**
+   * @brief Round trip statistics of a command
+   *
+   * @param cmd radar command
+   * @return const RttStatistics& statistics of the command
+   */
+  const RttStatistics& rttStatistics(RadarCommand cmd) const;
+
+  /**
+   * @brief Set the number of retries after an ACK timeout. Every retry
+   * doubles the timeout. Restart, factory reset, baud rate change and the
+   * config mode commands are never repeated.
+   *
+   * @param retries number of retries, default 1
+   */
+  void setRetries(uint8_t retries);
+#endif
+
+#if LD2410_CONFIG_COMMANDS
   /**
    * @brief Configure the radars maximums detection range for moving and
    * stationary targets.
@@ -231,7 +481,9 @@ class LD2410 {
    * @return false Command executed with errors
    */
   bool setMaxDistAndDur(uint8_t maxMovingRange, uint8_t maxStationaryRange, uint16_t duration);
+#endif
 
+#if LD2410_READ_COMMANDS
   /**
    * @brief This command reads the current configuration parameters of the radar.
    *
@@ -240,6 +492,26 @@ class LD2410 {
    */
   bool readParameter();
 
+  /**
+   * @brief Reads the configuration parameters of the radar only if the cached
+   * parameters are not valid. The cache is updated by successful set commands
+   * and invalidated by factoryReset().
+   *
+   * @return true The cached parameters are valid
+   * @return false Failed to read the parameters
+   */
+  bool updateParameter();
+
+  /**
+   * @brief Check if the cached parameters match the radars configuration
+   *
+   * @return true The cached parameters are valid
+   * @return false The parameters need to be read from the radar
+   */
+  bool isParameterValid() const;
+#endif
+
+#if LD2410_CONFIG_COMMANDS
   /**
    * @brief Enable or disable the engineering mode
    *
@@ -261,6 +533,17 @@ class LD2410 {
    */
   bool setGateSensConf(uint8_t gate, uint8_t movingSensitivity, uint8_t stationarySensitivity);
 
+  /**
+   * @brief Set the sensitivity/thresholds of all gates in one configuration
+   * session. The commands are pipelined as far as the radars buffer allows.
+   *
+   * @param movingSensitivity Moving sensitivity 0-100% per gate
+   * @param stationarySensitivity Stationary sensitivity 0-100% per gate
+   * @return true Command executed successfully
+   * @return false Command executed with errors
+   */
+  bool setGateSensConf(const uint8_t movingSensitivity[9], const uint8_t stationarySensitivity[9]);
+
   /**
    * @brief Set the Baud Rate of the radar
    *
@@ -287,7 +570,9 @@ class LD2410 {
    * @return false Command executed with errors
    */
   bool restart();
+#endif
 
+#if LD2410_READ_COMMANDS
   /**
    * @brief Reads the radars firmware version
    *
@@ -295,16 +580,29 @@ class LD2410 {
    * @return false Command executed with errors
    */
   bool readFirmwareVersion();
+#endif
 
   // Reference to the radars cyclic Data
   const CyclicData& cyclicData = _cyclicData;
 
+#if LD2410_ENGINEERING_MODE
   // Reference to the radars engineering Data
   const EngineeringData& engineeringData = _engineeringData;
+#endif
 
+  // Reference to the frame counters of read()
+  const FrameStatistics& frameStatistics = _frameStatistics;
+
+#if LD2410_COMMANDS
   // Reference to the radars parameters
   const Parameter& parameter = _parameter;
 
+  // Reference to the last configuration mode session
+  const ConfigSession& configSession = _configSession;
+#endif
+
+#if LD2410_READ_COMMANDS
   // Reference to the radars firmware version
   const FirmwareVersion& firmwareVersion = _firmwareVersion;
+#endif
 };
@@ -0,0 +1,123 @@
+#include "LD2410BackgroundModel.h"
+
+#if LD2410_ENGINEERING_MODE && LD2410_CONFIG_COMMANDS
+
+// integer square root, bit by bit without division
+static uint32_t isqrt(uint32_t value) {
+  uint32_t result = 0;
+  uint32_t bit    = 1UL << 30;
+
+  while (bit > value) {
+    bit >>= 2;
+  }
+
+  while (bit) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return result;
+}
+
+LD2410BackgroundModel::LD2410BackgroundModel(uint8_t shift) {
+  _shift  = shift;
+  _k      = 3;
+  _margin = 5;
+  reset();
+}
+
+void LD2410BackgroundModel::reset() {
+  _frames = 0;
+  memset(_movingMean, 0, sizeof(_movingMean));
+  memset(_stationaryMean, 0, sizeof(_stationaryMean));
+  memset(_movingVariance, 0, sizeof(_movingVariance));
+  memset(_stationaryVariance, 0, sizeof(_stationaryVariance));
+}
+
+bool LD2410BackgroundModel::update(const LD2410 &radar) {
+  if (!radar.cyclicData.radarInEngineeringMode || radar.cyclicData.targetState != NO_TARGET) {
+    return false;
+  }
+
+  update(radar.engineeringData.movingEnergyGateN, radar.engineeringData.stationaryEnergyGateN);
+  return true;
+}
+
+void LD2410BackgroundModel::update(const uint8_t movingEnergy[9], const uint8_t stationaryEnergy[9]) {
+  // start from the first frame instead of zero
+  if (_frames == 0) {
+    for (uint8_t gate = 0; gate <= 8; gate++) {
+      _movingMean[gate]     = int32_t(movingEnergy[gate]) << 8;
+      _stationaryMean[gate] = int32_t(stationaryEnergy[gate]) << 8;
+    }
+  }
+
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    _update(_movingMean[gate], _movingVariance[gate], movingEnergy[gate]);
+    _update(_stationaryMean[gate], _stationaryVariance[gate], stationaryEnergy[gate]);
+  }
+
+  _frames++;
+}
+
+void LD2410BackgroundModel::_update(int32_t &mean, int32_t &variance, uint8_t value) {
+  if (value > 100) {
+    value = 100;
+  }
+
+  // deviation from the mean, 8 fractional bits, max. 100 << 8 so the square fits
+  int32_t delta = (int32_t(value) << 8) - mean;
+
+  mean += delta >> _shift;
+  variance += (((delta * delta) >> 8) - variance) >> _shift;
+}
+
+bool LD2410BackgroundModel::isReady() const {
+  // the EWMA has settled after a few time constants
+  return _frames >= (4UL << _shift);
+}
+
+void LD2410BackgroundModel::setThresholdRule(uint8_t k, uint8_t margin) {
+  _k      = k;
+  _margin = margin;
+}
+
+uint8_t LD2410BackgroundModel::_threshold(int32_t mean, int32_t variance) const {
+  // sigma with 8 fractional bits
+  uint32_t sigma = isqrt(uint32_t(variance < 0 ? 0 : variance) << 8);
+
+  int32_t threshold = ((mean + int32_t(_k * sigma)) >> 8) + _margin;
+  if (threshold < 0) {
+    return 0;
+  }
+  return threshold > 100 ? 100 : threshold;
+}
+
+void LD2410BackgroundModel::proposeThresholds(uint8_t movingSensitivity[9], uint8_t stationarySensitivity[9]) const {
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    movingSensitivity[gate]     = _threshold(_movingMean[gate], _movingVariance[gate]);
+    stationarySensitivity[gate] = _threshold(_stationaryMean[gate], _stationaryVariance[gate]);
+  }
+}
+
+bool LD2410BackgroundModel::apply(LD2410 &radar) const {
+  if (!isReady()) {
+    return false;
+  }
+
+  uint8_t movingSensitivity[9];
+  uint8_t stationarySensitivity[9];
+  proposeThresholds(movingSensitivity, stationarySensitivity);
+
+  return radar.setGateSensConf(movingSensitivity, stationarySensitivity);
+}
+
+uint32_t LD2410BackgroundModel::frames() const {
+  return _frames;
+}
+
+#endif
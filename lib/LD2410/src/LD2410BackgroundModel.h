@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "LD2410.h"
+
+// needs the engineering data and the configuration commands
+#if LD2410_ENGINEERING_MODE && LD2410_CONFIG_COMMANDS
+
+/**
+ * @brief Streaming background model of the gate energies of an empty room.
+ *
+ * Keeps an exponentially weighted running mean and variance of the moving and
+ * stationary energy of every gate from the engineering data. Memory is fixed
+ * and every frame costs O(1) integer operations (shifts and one multiply per
+ * value, no division). From the model thresholds are proposed which can be
+ * written to the radar in one configuration session.
+ */
+class LD2410BackgroundModel {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param shift smoothing factor of the EWMA, alpha = 1 / 2^shift
+   */
+  explicit LD2410BackgroundModel(uint8_t shift = 5);
+
+  /**
+   * @brief Forgets everything learned so far
+   */
+  void reset();
+
+  /**
+   * @brief Adds the latest frame of the radar to the model. Only frames in
+   * engineering mode without a detected target are used.
+   *
+   * @param radar radar which received the frame
+   * @return true The frame was added
+   * @return false The frame was skipped
+   */
+  bool update(const LD2410& radar);
+
+  /**
+   * @brief Adds the energies of one frame to the model
+   *
+   * @param movingEnergy moving energy per gate 0-100 %
+   * @param stationaryEnergy stationary energy per gate 0-100 %
+   */
+  void update(const uint8_t movingEnergy[9], const uint8_t stationaryEnergy[9]);
+
+  /**
+   * @brief Check if enough frames were learned to propose thresholds
+   *
+   * @return true The model has settled
+   * @return false More frames are needed
+   */
+  bool isReady() const;
+
+  /**
+   * @brief Set how the thresholds are proposed: mean + k * sigma + margin
+   *
+   * @param k number of standard deviations above the mean
+   * @param margin additional margin in %
+   */
+  void setThresholdRule(uint8_t k, uint8_t margin);
+
+  /**
+   * @brief Proposes thresholds per gate from the model
+   *
+   * @param movingSensitivity proposed moving sensitivity 0-100 % per gate
+   * @param stationarySensitivity proposed stationary sensitivity 0-100 % per gate
+   */
+  void proposeThresholds(uint8_t movingSensitivity[9], uint8_t stationarySensitivity[9]) const;
+
+  /**
+   * @brief Writes the proposed thresholds to the radar in one batch
+   *
+   * @param radar radar to configure
+   * @return true The thresholds were applied
+   * @return false The model is not ready or the command failed
+   */
+  bool apply(LD2410& radar) const;
+
+  /**
+   * @brief Number of frames added to the model
+   */
+  uint32_t frames() const;
+
+ private:
+  /**
+   * @brief Adds one value to the mean and variance of a gate
+   */
+  void _update(int32_t& mean, int32_t& variance, uint8_t value);
+
+  /**
+   * @brief Proposed threshold from the mean and variance of a gate
+   */
+  uint8_t _threshold(int32_t mean, int32_t variance) const;
+
+  // smoothing factor of the EWMA, alpha = 1 / 2^shift
+  uint8_t _shift;
+
+  // number of standard deviations above the mean
+  uint8_t _k;
+
+  // additional margin of the threshold in %
+  uint8_t _margin;
+
+  // frames added to the model
+  uint32_t _frames;
+
+  // mean energy per gate, fixed point with 8 fractional bits
+  int32_t _movingMean[9];
+  int32_t _stationaryMean[9];
+
+  // energy variance per gate, fixed point with 8 fractional bits
+  int32_t _movingVariance[9];
+  int32_t _stationaryVariance[9];
+};
+
+#endif
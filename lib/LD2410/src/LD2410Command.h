@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// command header + frame length + command word + command tail
+#define LD2410_COMMAND_OVERHEAD 12
+
+/**
+ * @brief Command frame for the radar, encoded in one buffer.
+ *
+ * The buffer size is fixed at compile time by the payload size of the
+ * command, so a frame lives on the stack and is sent with one write().
+ * Header, length, command word and tail are written by the constructor,
+ * the payload is appended in protocol order. Payload bytes which are not
+ * appended stay 0.
+ *
+ * @tparam DATA_SIZE payload size in bytes
+ */
+template <size_t DATA_SIZE>
+class LD2410CommandFrame {
+ public:
+  // size of the whole frame in bytes
+  static const size_t SIZE = LD2410_COMMAND_OVERHEAD + DATA_SIZE;
+
+  /**
+   * @brief Constructor
+   *
+   * @param cmd command word, high byte is sent first
+   */
+  explicit LD2410CommandFrame(uint16_t cmd) : _size(8) {
+    // command header
+    _buffer[0] = 0xFD;
+    _buffer[1] = 0xFC;
+    _buffer[2] = 0xFB;
+    _buffer[3] = 0xFA;
+
+    // frame data length: command word + payload
+    _buffer[4] = (uint8_t)(2 + DATA_SIZE);
+    _buffer[5] = (uint8_t)((2 + DATA_SIZE) >> 8);
+
+    // command word
+    _buffer[6] = (uint8_t)(cmd >> 8);
+    _buffer[7] = (uint8_t)cmd;
+
+    for (size_t i = 8; i < SIZE - 4; i++) {
+      _buffer[i] = 0x00;
+    }
+
+    // command tail
+    _buffer[SIZE - 4] = 0x04;
+    _buffer[SIZE - 3] = 0x03;
+    _buffer[SIZE - 2] = 0x02;
+    _buffer[SIZE - 1] = 0x01;
+  }
+
+  /**
+   * @brief Appends a 16 bit value, little-endian
+   *
+   * @param value value to append
+   * @return LD2410CommandFrame& this frame
+   */
+  LD2410CommandFrame& add16(uint16_t value) {
+    _add(value, 2);
+    return *this;
+  }
+
+  /**
+   * @brief Appends a 32 bit value, little-endian
+   *
+   * @param value value to append
+   * @return LD2410CommandFrame& this frame
+   */
+  LD2410CommandFrame& add32(uint32_t value) {
+    _add(value, 4);
+    return *this;
+  }
+
+  /**
+   * @brief Appends a parameter: 16 bit parameter word and 32 bit value
+   *
+   * @param word parameter word
+   * @param value parameter value
+   * @return LD2410CommandFrame& this frame
+   */
+  LD2410CommandFrame& addParameter(uint16_t word, uint32_t value) {
+    _add(word, 2);
+    _add(value, 4);
+    return *this;
+  }
+
+  /**
+   * @brief The encoded frame
+   */
+  const uint8_t* data() const { return _buffer; }
+
+  /**
+   * @brief Size of the encoded frame in bytes
+   */
+  size_t size() const { return SIZE; }
+
+ private:
+  void _add(uint32_t value, uint8_t bytes) {
+    // the payload size is fixed, ignore anything beyond it
+    if (_size + bytes > SIZE - 4) {
+      return;
+    }
+
+    for (uint8_t i = 0; i < bytes; i++) {
+      _buffer[_size++] = (uint8_t)(value >> (8 * i));
+    }
+  }
+
+  uint8_t _buffer[SIZE];
+  size_t _size;
+};
+
+// command without payload
+typedef LD2410CommandFrame<0> LD2410EmptyCommand;
+
+// command with one 16 bit value, e.g. enable config mode, set baud rate
+typedef LD2410CommandFrame<2> LD2410ValueCommand;
+
+// command with three parameters, e.g. set max distance and duration, set gate sensitivity
+typedef LD2410CommandFrame<18> LD2410ParameterCommand;
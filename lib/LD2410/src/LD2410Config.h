@@ -0,0 +1,32 @@
+#pragma once
+
+/*
+ * Compile time features of the LD2410 library.
+ *
+ * Every feature is enabled by default, override with build flags, e.g. in
+ * platformio.ini:
+ *
+ *   build_flags = -D LD2410_ENGINEERING_MODE=0 -D LD2410_CONFIG_COMMANDS=0 -D LD2410_READ_COMMANDS=0
+ *
+ * With all features disabled only read() and the cyclic data are left, a
+ * presence only build is then just the frame parser.
+ */
+
+// parse the engineering data (energy per gate) of the radar frames
+#ifndef LD2410_ENGINEERING_MODE
+#define LD2410_ENGINEERING_MODE 1
+#endif
+
+// configuration commands: setMaxDistAndDur(), setGateSensConf(), enableEngMode(),
+// setBaudRate(), factoryReset() and restart()
+#ifndef LD2410_CONFIG_COMMANDS
+#define LD2410_CONFIG_COMMANDS 1
+#endif
+
+// read back commands: begin(), readFirmwareVersion(), readParameter() and updateParameter()
+#ifndef LD2410_READ_COMMANDS
+#define LD2410_READ_COMMANDS 1
+#endif
+
+// command transport (config mode session, ACK handling, round trip statistics)
+#define LD2410_COMMANDS (LD2410_CONFIG_COMMANDS || LD2410_READ_COMMANDS)
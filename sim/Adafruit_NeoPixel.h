@@ -0,0 +1,49 @@
+/*
+File: Adafruit_NeoPixel.h
+Linux shim of Adafruit_NeoPixel for the headless firmware simulation.
+
+Pixels are stored like the original library (wire order, brightness
+applied in setPixelColor()). Every show() is handed to the frame log
+and advances the virtual clock by the WS2812 transmit time.
+*/
+#ifndef SIM_ADAFRUIT_NEOPIXEL_H
+#define SIM_ADAFRUIT_NEOPIXEL_H
+
+#include <Arduino.h>
+
+#define NEO_GRB    ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_RGB    ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+ public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin, uint16_t type);
+  ~Adafruit_NeoPixel();
+
+  void begin() {}
+  void show();
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+  void setPixelColor(uint16_t n, uint32_t c);
+  void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0);
+  void setBrightness(uint8_t brightness);
+  void clear();
+
+  uint8_t *getPixels() const { return pixels; }
+  uint8_t getBrightness() const { return brightness - 1; }
+  uint16_t numPixels() const { return numLEDs; }
+  uint32_t getPixelColor(uint16_t n) const;
+
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+
+ private:
+  uint16_t numLEDs;
+  uint8_t brightness;  // stored + 1 like the original, 0 = full
+  uint8_t *pixels;
+  uint8_t rOffset;
+  uint8_t gOffset;
+  uint8_t bOffset;
+};
+
+#endif  // SIM_ADAFRUIT_NEOPIXEL_H
@@ -0,0 +1,111 @@
+/*
+File: Arduino.h
+Linux shim of the Arduino API for the headless firmware simulation.
+
+Time is virtual: delay() advances the clock instantly and every call to
+millis()/micros() costs one microsecond, so busy waits terminate.
+*/
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  2
+#define FALLING 3
+#define RISING  4
+
+#define lowByte(w)  ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+// Time, 32 bit like unsigned long on the RP2040 so the values wrap the same:
+// micros() after 71.6 minutes, millis() after 49.7 days
+uint32_t millis();
+uint32_t micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// GPIO
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(int interrupt, void (*isr)(), int mode);
+void detachInterrupt(int interrupt);
+void noInterrupts();
+void interrupts();
+
+// Sleep until the next interrupt, here the next radar event
+void __wfi();
+
+// Random
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+
+  size_t print(const char *str);
+  size_t print(char c);
+  size_t print(int value) { return print((long)value); }
+  size_t print(unsigned int value) { return print((unsigned long)value); }
+  size_t print(long value);
+  size_t print(unsigned long value);
+  size_t print(double value);
+
+  size_t println() { return print("\n"); }
+  template <typename T>
+  size_t println(T value) { return print(value) + println(); }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  virtual void flush() {}
+};
+
+// USB serial, output goes to stdout if enabled
+class SimSerial : public Stream {
+ public:
+  void begin(unsigned long baud) { (void)baud; }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  size_t write(uint8_t c) override;
+  using Print::write;
+  operator bool() const { return true; }
+};
+
+// UART to the simulated radar
+class SimRadarSerial : public Stream {
+ public:
+  void begin(unsigned long baud) { (void)baud; }
+  int available() override;
+  int read() override;
+  size_t write(uint8_t c) override;
+  using Print::write;
+};
+
+extern SimSerial Serial;
+extern SimRadarSerial Serial1;
+
+#endif  // SIM_ARDUINO_H
@@ -0,0 +1,63 @@
+/*
+File: sim.h
+Internal interface between the shims, the simulated radar and the
+simulation driver.
+*/
+#ifndef SIM_H
+#define SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Virtual clock in microseconds
+uint64_t sim_now_us();
+void sim_advance_us(uint64_t us);
+
+// Simulated GPIO, fires the attached interrupt on a matching edge
+void sim_set_pin(uint8_t pin, bool level);
+
+// Print USB serial output to stdout
+extern bool sim_serial_echo;
+
+// One step of a radar scenario, active until the next step
+struct Sim_step {
+  uint32_t time_ms;
+  uint8_t target_state;
+  uint16_t moving_distance;
+  uint8_t moving_energy;
+  uint16_t stationary_distance;
+  uint8_t stationary_energy;
+};
+
+// Simulated LD2410: answers commands and sends a data frame every interval
+void sim_radar_load(const Sim_step *steps, size_t count);
+bool sim_radar_load_file(const char *path);
+void sim_radar_poll();
+uint64_t sim_radar_next_event_us();
+int sim_radar_available();
+int sim_radar_read();
+void sim_radar_write(uint8_t c);
+uint8_t sim_radar_target_state();
+
+// Frame log of every show()
+struct Sim_stats {
+  uint64_t shows;
+  uint64_t lit_shows;          // shows with at least one pixel on
+  uint64_t loops;
+  uint64_t max_loop_us;        // longest loop() in virtual time
+  uint64_t busy_us;            // virtual time spent inside loop()
+  uint64_t sleep_us;           // virtual time spent in __wfi()
+  uint32_t presence_events;    // scenario changes from no target to target
+  bool presence_pending;       // waiting for the first lit show after a presence event
+  uint64_t presence_start_us;
+  uint64_t light_latency_sum_us;
+  uint64_t light_latency_max_us;
+};
+
+extern Sim_stats sim_stats;
+
+bool sim_frames_open(const char *log_path, const char *ppm_path);
+void sim_frames_show(const uint8_t *pixels, uint16_t count, uint8_t r_offset, uint8_t g_offset, uint8_t b_offset);
+void sim_frames_close();
+
+#endif  // SIM_H
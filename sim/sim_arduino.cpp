@@ -0,0 +1,187 @@
+/*
+File: sim_arduino.cpp
+Virtual clock, GPIO and serial ports of the headless firmware simulation.
+*/
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "sim.h"
+
+// Virtual time of one call to millis() or micros()
+#define SIM_CLOCK_CALL_US 1
+
+#define SIM_NUM_PINS 30
+
+static uint64_t now_us = 0;
+
+static bool pin_level[SIM_NUM_PINS];
+static void (*pin_isr[SIM_NUM_PINS])();
+static int pin_isr_mode[SIM_NUM_PINS];
+
+bool sim_serial_echo = false;
+
+SimSerial Serial;
+SimRadarSerial Serial1;
+
+uint64_t sim_now_us() {
+  return now_us;
+}
+
+void sim_advance_us(uint64_t us) {
+  now_us += us;
+}
+
+// Truncated like on the RP2040, unsigned long has 64 bit on the host
+uint32_t millis() {
+  now_us += SIM_CLOCK_CALL_US;
+  return (uint32_t)(now_us / 1000);
+}
+
+uint32_t micros() {
+  now_us += SIM_CLOCK_CALL_US;
+  return (uint32_t)now_us;
+}
+
+void delay(unsigned long ms) {
+  now_us += (uint64_t)ms * 1000;
+  sim_radar_poll();
+}
+
+void delayMicroseconds(unsigned int us) {
+  now_us += us;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < SIM_NUM_PINS && pin_level[pin] ? HIGH : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < SIM_NUM_PINS) {
+    pin_level[pin] = value;
+  }
+}
+
+int analogRead(uint8_t pin) {
+  return pin;
+}
+
+int digitalPinToInterrupt(uint8_t pin) {
+  return pin;
+}
+
+void attachInterrupt(int interrupt, void (*isr)(), int mode) {
+  if (interrupt >= 0 && interrupt < SIM_NUM_PINS) {
+    pin_isr[interrupt] = isr;
+    pin_isr_mode[interrupt] = mode;
+  }
+}
+
+void detachInterrupt(int interrupt) {
+  if (interrupt >= 0 && interrupt < SIM_NUM_PINS) {
+    pin_isr[interrupt] = NULL;
+  }
+}
+
+void noInterrupts() {
+}
+
+void interrupts() {
+}
+
+void __wfi() {
+  sim_radar_poll();
+  if (sim_radar_available()) {
+    return;
+  }
+
+  uint64_t next_us = sim_radar_next_event_us();
+  if (next_us > now_us) {
+    sim_stats.sleep_us += next_us - now_us;
+    now_us = next_us;
+  }
+  sim_radar_poll();
+}
+
+void sim_set_pin(uint8_t pin, bool level) {
+  if (pin >= SIM_NUM_PINS || pin_level[pin] == level) {
+    return;
+  }
+
+  pin_level[pin] = level;
+
+  int mode = pin_isr_mode[pin];
+  if (pin_isr[pin] && (mode == CHANGE || (mode == RISING && level) || (mode == FALLING && !level))) {
+    pin_isr[pin]();
+  }
+}
+
+long random(long max) {
+  return max > 0 ? rand() % max : 0;
+}
+
+long random(long min, long max) {
+  return max > min ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed) {
+  srand(seed);
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    write(buffer[i]);
+  }
+  return size;
+}
+
+size_t Print::print(const char *str) {
+  return write(str);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(long value) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%ld", value);
+  return write(buffer);
+}
+
+size_t Print::print(unsigned long value) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%lu", value);
+  return write(buffer);
+}
+
+size_t Print::print(double value) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.2f", value);
+  return write(buffer);
+}
+
+size_t SimSerial::write(uint8_t c) {
+  if (sim_serial_echo) {
+    putchar(c);
+  }
+  return 1;
+}
+
+int SimRadarSerial::available() {
+  sim_radar_poll();
+  return sim_radar_available();
+}
+
+int SimRadarSerial::read() {
+  return sim_radar_read();
+}
+
+size_t SimRadarSerial::write(uint8_t c) {
+  sim_radar_write(c);
+  return 1;
+}
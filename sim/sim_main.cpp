@@ -0,0 +1,152 @@
+/*
+File: sim_main.cpp
+Headless firmware simulation: runs setup() and loop() of src/main.cpp on
+Linux against the shims in this folder, with a virtual clock.
+
+  sim [--scenario file] [--duration s] [--tick us] [--frames file] [--ppm file] [--echo]
+
+Without a scenario the room is empty for 80 s, then a person walks in, stays,
+and leaves, every 2 minutes.
+When loop() is idle the clock jumps to the next radar event, at most
+--tick microseconds, so hours of behaviour run in seconds.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+#include "sim.h"
+
+// Firmware entry points in src/main.cpp
+void setup();
+void loop();
+
+#define SIM_DEFAULT_DURATION_S 600
+#define SIM_DEFAULT_TICK_US    1000
+
+Sim_stats sim_stats;
+
+// Every two minutes: empty for 80 s (longer than the idle timeout), walk in,
+// stand still, walk out
+static std::vector<Sim_step> Default_scenario(uint32_t duration_s) {
+  std::vector<Sim_step> steps;
+  for (uint32_t cycle_ms = 0; cycle_ms < duration_s * 1000; cycle_ms += 120000) {
+    steps.push_back({cycle_ms + 0, 0x00, 0, 0, 0, 0});
+    steps.push_back({cycle_ms + 80000, 0x01, 400, 60, 0, 0});
+    steps.push_back({cycle_ms + 85000, 0x03, 200, 40, 200, 50});
+    steps.push_back({cycle_ms + 90000, 0x02, 0, 0, 200, 50});
+    steps.push_back({cycle_ms + 105000, 0x01, 350, 55, 0, 0});
+  }
+  return steps;
+}
+
+static double Wall_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void Usage(const char *name) {
+  fprintf(stderr,
+          "usage: %s [--scenario file] [--duration s] [--tick us] [--frames file] [--ppm file] [--echo]\n",
+          name);
+}
+
+int main(int argc, char **argv) {
+  const char *scenario_path = NULL;
+  const char *frames_path = NULL;
+  const char *ppm_path = NULL;
+  uint32_t duration_s = SIM_DEFAULT_DURATION_S;
+  uint64_t tick_us = SIM_DEFAULT_TICK_US;
+
+  for (int i = 1; i < argc; i++) {
+    bool has_value = i + 1 < argc;
+    if (!strcmp(argv[i], "--scenario") && has_value) {
+      scenario_path = argv[++i];
+    } else if (!strcmp(argv[i], "--duration") && has_value) {
+      duration_s = strtoul(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--tick") && has_value) {
+      tick_us = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--frames") && has_value) {
+      frames_path = argv[++i];
+    } else if (!strcmp(argv[i], "--ppm") && has_value) {
+      ppm_path = argv[++i];
+    } else if (!strcmp(argv[i], "--echo")) {
+      sim_serial_echo = true;
+    } else {
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (scenario_path) {
+    if (!sim_radar_load_file(scenario_path)) {
+      fprintf(stderr, "can't read scenario %s\n", scenario_path);
+      return 1;
+    }
+  } else {
+    std::vector<Sim_step> steps = Default_scenario(duration_s);
+    sim_radar_load(steps.data(), steps.size());
+  }
+
+  if (!sim_frames_open(frames_path, ppm_path)) {
+    fprintf(stderr, "can't open frame output\n");
+    return 1;
+  }
+
+  double wall_start = Wall_seconds();
+  uint64_t end_us = (uint64_t)duration_s * 1000000;
+
+  setup();
+  uint64_t setup_us = sim_now_us();
+
+  while (sim_now_us() < end_us) {
+    uint64_t loop_start_us = sim_now_us();
+    uint64_t sleep_start_us = sim_stats.sleep_us;
+    loop();
+    uint64_t loop_us = sim_now_us() - loop_start_us - (sim_stats.sleep_us - sleep_start_us);
+
+    sim_stats.loops++;
+    sim_stats.busy_us += loop_us;
+    if (loop_us > sim_stats.max_loop_us) {
+      sim_stats.max_loop_us = loop_us;
+    }
+
+    // Idle: jump to the next radar event
+    sim_radar_poll();
+    if (!sim_radar_available()) {
+      uint64_t now_us = sim_now_us();
+      uint64_t next_us = sim_radar_next_event_us();
+      if (next_us > now_us + tick_us) {
+        next_us = now_us + tick_us;
+      }
+      if (next_us > now_us) {
+        sim_advance_us(next_us - now_us);
+      }
+    }
+  }
+
+  sim_frames_close();
+
+  double wall_s = Wall_seconds() - wall_start;
+  double virtual_s = sim_now_us() / 1e6;
+  double run_s = (sim_now_us() - setup_us) / 1e6;
+  uint32_t latencies = sim_stats.presence_events - (sim_stats.presence_pending ? 1 : 0);
+
+  printf("virtual time      %.1f s (setup %.1f s)\n", virtual_s, setup_us / 1e6);
+  printf("wall time         %.3f s, %.0fx real time\n", wall_s, wall_s > 0 ? virtual_s / wall_s : 0);
+  printf("loops             %llu, max %llu us, busy %.1f %%\n", (unsigned long long)sim_stats.loops,
+         (unsigned long long)sim_stats.max_loop_us, run_s > 0 ? sim_stats.busy_us / 1e4 / run_s : 0);
+  printf("sleep             %.1f %%\n", run_s > 0 ? sim_stats.sleep_us / 1e4 / run_s : 0);
+  printf("shows             %llu (%.1f fps), lit %llu\n", (unsigned long long)sim_stats.shows,
+         run_s > 0 ? sim_stats.shows / run_s : 0, (unsigned long long)sim_stats.lit_shows);
+  printf("presence events   %u\n", sim_stats.presence_events);
+  if (latencies) {
+    printf("presence to light avg %llu us, max %llu us\n",
+           (unsigned long long)(sim_stats.light_latency_sum_us / latencies),
+           (unsigned long long)sim_stats.light_latency_max_us);
+  }
+  return 0;
+}
@@ -0,0 +1,190 @@
+/*
+File: sim_neopixel.cpp
+Adafruit_NeoPixel shim and frame log of the headless firmware simulation.
+
+Frame log: one record per show()
+  uint32_t time_ms   virtual time
+  uint16_t count     number of LEDs
+  uint8_t  rgb[3 * count]
+PPM: one row per show(), one column per LED.
+*/
+#include <Adafruit_NeoPixel.h>
+#include <stdio.h>
+
+#include "sim.h"
+
+// WS2812 at 800 kHz: 30 us per LED plus 50 us reset
+#define SIM_WS2812_LED_US   30
+#define SIM_WS2812_RESET_US 50
+
+static FILE *frame_log = NULL;
+static FILE *frame_ppm = NULL;
+static uint16_t ppm_width = 0;
+static uint32_t ppm_rows = 0;
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, int16_t pin, uint16_t type)
+  : numLEDs(n), brightness(0) {
+  (void)pin;
+  rOffset = (type >> 4) & 0b11;
+  gOffset = (type >> 2) & 0b11;
+  bOffset = type & 0b11;
+  pixels = (uint8_t *)calloc(n, 3);
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel() {
+  free(pixels);
+}
+
+void Adafruit_NeoPixel::show() {
+  sim_advance_us((uint64_t)numLEDs * SIM_WS2812_LED_US + SIM_WS2812_RESET_US);
+  sim_frames_show(pixels, numLEDs, rOffset, gOffset, bOffset);
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+  if (n >= numLEDs) {
+    return;
+  }
+
+  if (brightness) {
+    r = (r * brightness) >> 8;
+    g = (g * brightness) >> 8;
+    b = (b * brightness) >> 8;
+  }
+
+  uint8_t *p = &pixels[n * 3];
+  p[rOffset] = r;
+  p[gOffset] = g;
+  p[bOffset] = b;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
+  setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+}
+
+void Adafruit_NeoPixel::fill(uint32_t c, uint16_t first, uint16_t count) {
+  if (first >= numLEDs) {
+    return;
+  }
+
+  uint16_t end = (count == 0 || first + count > numLEDs) ? numLEDs : first + count;
+  for (uint16_t i = first; i < end; i++) {
+    setPixelColor(i, c);
+  }
+}
+
+void Adafruit_NeoPixel::setBrightness(uint8_t b) {
+  uint8_t new_brightness = b + 1;
+  if (new_brightness == brightness) {
+    return;
+  }
+
+  // Rescale the stored pixels like the original library
+  uint8_t old_brightness = brightness - 1;
+  uint16_t scale;
+  if (old_brightness == 0) {
+    scale = 0;
+  } else if (b == 255) {
+    scale = 65535 / old_brightness;
+  } else {
+    scale = (((uint16_t)new_brightness << 8) - 1) / old_brightness;
+  }
+
+  for (uint16_t i = 0; i < numLEDs * 3; i++) {
+    pixels[i] = (pixels[i] * scale) >> 8;
+  }
+  brightness = new_brightness;
+}
+
+void Adafruit_NeoPixel::clear() {
+  memset(pixels, 0, numLEDs * 3);
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
+  if (n >= numLEDs) {
+    return 0;
+  }
+
+  const uint8_t *p = &pixels[n * 3];
+  return Color(p[rOffset], p[gOffset], p[bOffset]);
+}
+
+bool sim_frames_open(const char *log_path, const char *ppm_path) {
+  if (log_path && !(frame_log = fopen(log_path, "wb"))) {
+    return false;
+  }
+
+  if (ppm_path && !(frame_ppm = fopen(ppm_path, "wb"))) {
+    return false;
+  }
+
+  return true;
+}
+
+void sim_frames_show(const uint8_t *pixels, uint16_t count, uint8_t r_offset, uint8_t g_offset, uint8_t b_offset) {
+  sim_stats.shows++;
+
+  bool lit = false;
+  for (uint16_t i = 0; i < count * 3; i++) {
+    lit |= pixels[i] != 0;
+  }
+  if (lit) {
+    sim_stats.lit_shows++;
+
+    // Scenario presence to light latency
+    if (sim_stats.presence_pending) {
+      uint64_t latency_us = sim_now_us() - sim_stats.presence_start_us;
+      sim_stats.presence_pending = false;
+      sim_stats.light_latency_sum_us += latency_us;
+      if (latency_us > sim_stats.light_latency_max_us) {
+        sim_stats.light_latency_max_us = latency_us;
+      }
+    }
+  }
+
+  if (!frame_log && !frame_ppm) {
+    return;
+  }
+
+  uint8_t rgb[3 * 1024];
+  if (count > 1024) {
+    count = 1024;
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    rgb[i * 3 + 0] = pixels[i * 3 + r_offset];
+    rgb[i * 3 + 1] = pixels[i * 3 + g_offset];
+    rgb[i * 3 + 2] = pixels[i * 3 + b_offset];
+  }
+
+  if (frame_log) {
+    uint32_t time_ms = (uint32_t)(sim_now_us() / 1000);
+    fwrite(&time_ms, sizeof(time_ms), 1, frame_log);
+    fwrite(&count, sizeof(count), 1, frame_log);
+    fwrite(rgb, 3, count, frame_log);
+  }
+
+  if (frame_ppm) {
+    if (ppm_rows == 0) {
+      // Height is patched in sim_frames_close()
+      ppm_width = count;
+      fprintf(frame_ppm, "P6\n%u %10u\n255\n", ppm_width, 0u);
+    }
+    if (count == ppm_width) {
+      fwrite(rgb, 3, count, frame_ppm);
+      ppm_rows++;
+    }
+  }
+}
+
+void sim_frames_close() {
+  if (frame_log) {
+    fclose(frame_log);
+    frame_log = NULL;
+  }
+
+  if (frame_ppm) {
+    rewind(frame_ppm);
+    fprintf(frame_ppm, "P6\n%u %10u\n255\n", ppm_width, ppm_rows);
+    fclose(frame_ppm);
+    frame_ppm = NULL;
+  }
+}
@@ -0,0 +1,346 @@
+/*
+File: sim_radar.cpp
+Simulated LD2410 behind Serial1 of the headless firmware simulation.
+
+Answers the configuration commands with ACKs, sends a data frame every
+SIM_RADAR_FRAME_US from the active scenario step and drives the radar
+OUT pin.
+
+Like the real radar the OUT pin follows a scenario step at once, the data
+frames keep their own phase and every byte takes its UART time, so the
+pin leads the frame by up to a frame interval.
+
+Scenario file, one step per line, active until the next step:
+  <time s> <target state> <moving cm> <moving energy> <stationary cm> <stationary energy>
+Lines starting with # are comments.
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "sim.h"
+
+#define SIM_RADAR_OUT_PIN  2
+#define SIM_RADAR_FRAME_US 100000
+#define SIM_RADAR_ACK_US   1000
+#define SIM_RADAR_RX_SIZE  4096
+
+// First data frame, off the 100 ms grid of the scenario steps
+#define SIM_RADAR_FRAME_PHASE_US 37000
+
+// 256000 baud, 10 bits per byte
+#define SIM_RADAR_BYTE_US 39
+
+// Empty room energy per gate in engineering mode
+#define SIM_RADAR_NOISE_ENERGY 5
+
+struct Pending_ack {
+  uint64_t due_us;
+  uint8_t length;
+  uint8_t data[48];
+};
+
+static std::vector<Sim_step> steps;
+static size_t step_index = 0;
+static uint8_t last_target_state = 0;
+
+// Bytes can be read once they are received completely
+static uint8_t rx[SIM_RADAR_RX_SIZE];
+static uint64_t rx_due_us[SIM_RADAR_RX_SIZE];
+static size_t rx_head = 0;
+static size_t rx_ready = 0;
+static size_t rx_tail = 0;
+static uint64_t rx_line_free_us = 0;  // end of the last byte on the line
+
+static std::vector<Pending_ack> acks;
+static uint8_t cmd_buffer[64];
+static size_t cmd_length = 0;
+
+static bool is_eng_mode = false;
+static uint64_t next_frame_us = SIM_RADAR_FRAME_PHASE_US;
+
+static const uint8_t command_header[4] = {0xFD, 0xFC, 0xFB, 0xFA};
+static const uint8_t command_tail[4] = {0x04, 0x03, 0x02, 0x01};
+static const uint8_t data_header[4] = {0xF4, 0xF3, 0xF2, 0xF1};
+static const uint8_t data_tail[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+
+// Send at start_us, or once the line is free
+static void rx_push(const uint8_t *data, size_t length, uint64_t start_us) {
+  if (rx_line_free_us < start_us) {
+    rx_line_free_us = start_us;
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    size_t next = (rx_head + 1) % SIM_RADAR_RX_SIZE;
+    if (next == rx_tail) {
+      return;  // overflow, the firmware reads too slowly
+    }
+    rx_line_free_us += SIM_RADAR_BYTE_US;
+    rx[rx_head] = data[i];
+    rx_due_us[rx_head] = rx_line_free_us;
+    rx_head = next;
+  }
+}
+
+// Bytes received until now
+static void rx_receive(uint64_t now) {
+  while (rx_ready != rx_head && rx_due_us[rx_ready] <= now) {
+    rx_ready = (rx_ready + 1) % SIM_RADAR_RX_SIZE;
+  }
+}
+
+static void rx_frame(const uint8_t *header, const uint8_t *tail, const uint8_t *data, uint8_t length,
+                     uint64_t start_us) {
+  uint8_t len[2] = {length, 0};
+  rx_push(header, 4, start_us);
+  rx_push(len, 2, start_us);
+  rx_push(data, length, start_us);
+  rx_push(tail, 4, start_us);
+}
+
+static const Sim_step &current_step() {
+  static const Sim_step empty = {0, 0, 0, 0, 0, 0};
+  return steps.empty() ? empty : steps[step_index];
+}
+
+static void send_data_frame(uint64_t start_us) {
+  const Sim_step &step = current_step();
+  uint8_t data[48];
+  uint8_t n = 0;
+
+  uint16_t detection = step.moving_distance > step.stationary_distance ? step.moving_distance : step.stationary_distance;
+
+  data[n++] = is_eng_mode ? 0x01 : 0x02;
+  data[n++] = 0xAA;
+  data[n++] = step.target_state;
+  data[n++] = step.moving_distance & 0xFF;
+  data[n++] = step.moving_distance >> 8;
+  data[n++] = step.moving_energy;
+  data[n++] = step.stationary_distance & 0xFF;
+  data[n++] = step.stationary_distance >> 8;
+  data[n++] = step.stationary_energy;
+  data[n++] = detection & 0xFF;
+  data[n++] = detection >> 8;
+
+  if (is_eng_mode) {
+    data[n++] = 8;  // max moving gate
+    data[n++] = 8;  // max stationary gate
+
+    // Energy at the gate of the target, 0.75 m per gate
+    for (uint8_t gate = 0; gate <= 8; gate++) {
+      bool hit = step.moving_energy && step.moving_distance / 75 == gate;
+      data[n++] = hit ? step.moving_energy : SIM_RADAR_NOISE_ENERGY;
+    }
+    for (uint8_t gate = 0; gate <= 8; gate++) {
+      bool hit = step.stationary_energy && step.stationary_distance / 75 == gate;
+      data[n++] = hit ? step.stationary_energy : SIM_RADAR_NOISE_ENERGY;
+    }
+
+    data[n++] = 0;  // max moving energy
+    data[n++] = 0;  // max stationary energy
+  }
+
+  data[n++] = 0x55;
+  data[n++] = 0x00;
+
+  rx_frame(data_header, data_tail, data, n, start_us);
+}
+
+static void queue_ack(uint8_t cmd, const uint8_t *payload, uint8_t payload_length) {
+  Pending_ack ack;
+  ack.due_us = sim_now_us() + SIM_RADAR_ACK_US;
+  ack.length = 4 + payload_length;
+  ack.data[0] = cmd;
+  ack.data[1] = 0x01;  // ACK
+  ack.data[2] = 0x00;  // success
+  ack.data[3] = 0x00;
+  memcpy(&ack.data[4], payload, payload_length);
+  acks.push_back(ack);
+}
+
+static void handle_command(uint8_t cmd) {
+  switch (cmd) {
+    case 0xFF: {  // enable config mode: protocol version 1, buffer size 64
+      const uint8_t payload[] = {0x01, 0x00, 0x40, 0x00};
+      queue_ack(cmd, payload, sizeof(payload));
+      break;
+    }
+    case 0x61: {  // read parameter
+      uint8_t payload[24];
+      payload[0] = 0xAA;
+      payload[1] = 8;  // max gate
+      payload[2] = 8;  // max moving gate
+      payload[3] = 8;  // max stationary gate
+      memset(&payload[4], 40, 18);
+      payload[22] = 5;  // detection time
+      payload[23] = 0;
+      queue_ack(cmd, payload, sizeof(payload));
+      break;
+    }
+    case 0xA0: {  // read firmware version
+      const uint8_t payload[] = {0x00, 0x01, 0x02, 0x01, 0x16, 0x24, 0x06, 0x22};
+      queue_ack(cmd, payload, sizeof(payload));
+      break;
+    }
+    case 0x62:
+      is_eng_mode = true;
+      queue_ack(cmd, NULL, 0);
+      break;
+    case 0x63:
+      is_eng_mode = false;
+      queue_ack(cmd, NULL, 0);
+      break;
+    default:
+      queue_ack(cmd, NULL, 0);
+      break;
+  }
+}
+
+void sim_radar_write(uint8_t c) {
+  if (cmd_length < 4) {
+    // Find the command header
+    if (c == command_header[cmd_length]) {
+      cmd_buffer[cmd_length++] = c;
+    } else {
+      cmd_length = c == command_header[0] ? 1 : 0;
+    }
+    return;
+  }
+
+  if (cmd_length >= sizeof(cmd_buffer)) {
+    cmd_length = 0;
+    return;
+  }
+
+  cmd_buffer[cmd_length++] = c;
+
+  if (cmd_length < 6) {
+    return;
+  }
+
+  size_t length = cmd_buffer[4] | cmd_buffer[5] << 8;
+  if (cmd_length == 6 + length + 4) {
+    if (!memcmp(&cmd_buffer[6 + length], command_tail, 4)) {
+      handle_command(cmd_buffer[6]);
+    }
+    cmd_length = 0;
+  }
+}
+
+void sim_radar_poll() {
+  uint64_t now = sim_now_us();
+
+  // Scenario step
+  while (step_index + 1 < steps.size() && (uint64_t)steps[step_index + 1].time_ms * 1000 <= now) {
+    step_index++;
+  }
+
+  uint8_t target_state = current_step().target_state;
+  if (target_state != last_target_state) {
+    if (last_target_state == 0) {
+      sim_stats.presence_events++;
+      sim_stats.presence_pending = true;
+      sim_stats.presence_start_us = now;
+    }
+    last_target_state = target_state;
+    sim_set_pin(SIM_RADAR_OUT_PIN, target_state != 0);
+  }
+
+  // Command ACKs
+  for (size_t i = 0; i < acks.size();) {
+    if (acks[i].due_us <= now) {
+      rx_frame(command_header, command_tail, acks[i].data, acks[i].length, acks[i].due_us);
+      acks.erase(acks.begin() + i);
+    } else {
+      i++;
+    }
+  }
+
+  // Cyclic data frames
+  while (next_frame_us <= now) {
+    send_data_frame(next_frame_us);
+    next_frame_us += SIM_RADAR_FRAME_US;
+  }
+
+  rx_receive(now);
+}
+
+uint64_t sim_radar_next_event_us() {
+  uint64_t next = next_frame_us;
+
+  if (step_index + 1 < steps.size() && (uint64_t)steps[step_index + 1].time_ms * 1000 < next) {
+    next = (uint64_t)steps[step_index + 1].time_ms * 1000;
+  }
+
+  for (size_t i = 0; i < acks.size(); i++) {
+    if (acks[i].due_us < next) {
+      next = acks[i].due_us;
+    }
+  }
+
+  // Next byte on the line
+  if (rx_ready != rx_head && rx_due_us[rx_ready] < next) {
+    next = rx_due_us[rx_ready];
+  }
+  return next;
+}
+
+int sim_radar_available() {
+  rx_receive(sim_now_us());
+  return (int)((rx_ready + SIM_RADAR_RX_SIZE - rx_tail) % SIM_RADAR_RX_SIZE);
+}
+
+int sim_radar_read() {
+  rx_receive(sim_now_us());
+  if (rx_ready == rx_tail) {
+    return -1;
+  }
+
+  uint8_t c = rx[rx_tail];
+  rx_tail = (rx_tail + 1) % SIM_RADAR_RX_SIZE;
+  return c;
+}
+
+uint8_t sim_radar_target_state() {
+  return current_step().target_state;
+}
+
+void sim_radar_load(const Sim_step *scenario, size_t count) {
+  steps.assign(scenario, scenario + count);
+  step_index = 0;
+}
+
+bool sim_radar_load_file(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    return false;
+  }
+
+  steps.clear();
+  step_index = 0;
+
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#') {
+      continue;
+    }
+
+    double time_s;
+    unsigned state, moving_cm, moving_energy, stationary_cm, stationary_energy;
+    if (sscanf(line, "%lf %u %u %u %u %u", &time_s, &state, &moving_cm, &moving_energy,
+               &stationary_cm, &stationary_energy) == 6) {
+      Sim_step step;
+      step.time_ms = (uint32_t)(time_s * 1000);
+      step.target_state = state;
+      step.moving_distance = moving_cm;
+      step.moving_energy = moving_energy;
+      step.stationary_distance = stationary_cm;
+      step.stationary_energy = stationary_energy;
+      steps.push_back(step);
+    }
+  }
+
+  fclose(file);
+  return !steps.empty();
+}
@@ -0,0 +1,132 @@
+/*
+File: clip.cpp
+Playback of compressed LED animation clips stored in flash.
+*/
+#include "clip.h"
+
+#define CLIP_OP_MASK    0xC0
+#define CLIP_OP_SKIP    0x00
+#define CLIP_OP_REPEAT  0x80
+#define CLIP_OP_LITERAL 0xC0
+#define CLIP_RUN_MASK   0x3F
+
+// A late update() skips at most this many frames, then restarts the timing
+#define CLIP_MAX_CATCH_UP 8
+
+static uint16_t Read_u16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+
+ClipPlayer::ClipPlayer()
+  : _clip(nullptr),
+    _pos(nullptr),
+    _loop(false),
+    _led_count(0),
+    _frame_count(0),
+    _frame_ms(0),
+    _frame_index(0),
+    _next_ms(0) {
+}
+
+bool ClipPlayer::start(const uint8_t *clip, bool loop, uint32_t now_ms) {
+  _clip = nullptr;
+
+  if (!clip || clip[0] != 'L' || clip[1] != 'C' || clip[2] != CLIP_VERSION) {
+    return false;
+  }
+
+  _led_count = Read_u16(&clip[4]);
+  _frame_count = Read_u16(&clip[6]);
+  _frame_ms = Read_u16(&clip[8]);
+  if (_frame_count == 0 || _frame_ms == 0) {
+    return false;
+  }
+
+  _clip = clip;
+  _pos = clip + CLIP_HEADER_SIZE;
+  _loop = loop;
+  _frame_index = 0;
+  _next_ms = now_ms;
+  return true;
+}
+
+void ClipPlayer::stop() {
+  _clip = nullptr;
+}
+
+bool ClipPlayer::update(Adafruit_NeoPixel &strip, uint32_t now_ms) {
+  if (!_clip || (int32_t)(now_ms - _next_ms) < 0) {
+    return false;
+  }
+
+  // Deltas need every frame, decode the missed ones too
+  uint8_t frames = 0;
+  while (_clip && (int32_t)(now_ms - _next_ms) >= 0) {
+    if (++frames > CLIP_MAX_CATCH_UP) {
+      _next_ms = now_ms;
+    }
+    _next_ms += _frame_ms;
+
+    if (!decode_frame(strip)) {
+      stop();
+    }
+  }
+  return true;
+}
+
+bool ClipPlayer::decode_frame(Adafruit_NeoPixel &strip) {
+  if (!_clip) {
+    return false;
+  }
+
+  if (_frame_index >= _frame_count) {
+    if (!_loop) {
+      return false;
+    }
+    // Frame 0 is a keyframe
+    _pos = _clip + CLIP_HEADER_SIZE;
+    _frame_index = 0;
+  }
+
+  const uint8_t *p = _pos;
+  uint8_t type = *p++;
+
+  if (type == CLIP_FRAME_KEY) {
+    strip.fill(0, 0, _led_count);
+  } else if (type != CLIP_FRAME_DELTA) {
+    return false;
+  }
+
+  uint16_t led = 0;
+  while (led < _led_count) {
+    uint8_t op = *p++;
+    uint16_t run = (op & CLIP_RUN_MASK) + 1;
+
+    if (led + run > _led_count) {
+      return false;
+    }
+
+    switch (op & CLIP_OP_MASK) {
+      case CLIP_OP_SKIP:
+        led += run;
+        break;
+      case CLIP_OP_REPEAT:
+        strip.fill(Adafruit_NeoPixel::Color(p[0], p[1], p[2]), led, run);
+        p += 3;
+        led += run;
+        break;
+      case CLIP_OP_LITERAL:
+        while (run--) {
+          strip.setPixelColor(led++, p[0], p[1], p[2]);
+          p += 3;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+
+  _pos = p;
+  _frame_index++;
+  return true;
+}
@@ -0,0 +1,87 @@
+/*
+File: governor.cpp
+Frame time budget governor for the LED effects.
+*/
+#include "governor.h"
+
+// Frames in a row before the quality level changes
+#define GOVERNOR_DOWN_FRAMES 2
+#define GOVERNOR_UP_FRAMES   50
+
+FrameGovernor::FrameGovernor(uint32_t period_us, uint32_t read_reserve_us)
+  : _period_us(period_us),
+    _read_reserve_us(read_reserve_us < period_us ? read_reserve_us : 0),
+    _level(QUALITY_HIGH),
+    _start_us(0),
+    _last_start_us(0),
+    _last_end_us(0),
+    _over_in_row(0),
+    _under_in_row(0),
+    _overruns(),
+    _reserve_misses(0),
+    _cost(),
+    _period_cost() {
+}
+
+void FrameGovernor::frame_start(uint32_t now_us) {
+  _start_us = now_us;
+}
+
+bool FrameGovernor::frame_due(uint32_t now_us) const {
+  if (_cost.count == 0) {
+    return true;
+  }
+  return now_us - _last_start_us >= frame_period_us() && now_us - _last_end_us >= _read_reserve_us;
+}
+
+void FrameGovernor::frame_end(uint32_t now_us) {
+  uint32_t cost_us = now_us - _start_us;
+
+  // Spread over the time since the previous frame, at least one period
+  uint32_t span_us = _period_us;
+  if (_cost.count > 0) {
+    if (_start_us - _last_end_us < _read_reserve_us) {
+      _reserve_misses++;
+    }
+    if (_start_us - _last_start_us > span_us) {
+      span_us = _start_us - _last_start_us;
+    }
+  }
+  uint32_t period_cost_us = (uint64_t)cost_us * _period_us / span_us;
+
+  _last_start_us = _start_us;
+  _last_end_us = now_us;
+  _cost.add(cost_us);
+  _period_cost.add(period_cost_us);
+
+  if (period_cost_us > budget_us()) {
+    _overruns[_level]++;
+    _under_in_row = 0;
+
+    if (++_over_in_row >= GOVERNOR_DOWN_FRAMES && _level > QUALITY_LOW) {
+      _level = (Quality_level)(_level - 1);
+      _over_in_row = 0;
+    }
+    return;
+  }
+
+  _over_in_row = 0;
+
+  // The next level costs up to twice as much
+  if (period_cost_us < budget_us() / 2) {
+    if (++_under_in_row >= GOVERNOR_UP_FRAMES && _level < QUALITY_HIGH) {
+      _level = (Quality_level)(_level + 1);
+      _under_in_row = 0;
+    }
+  } else {
+    _under_in_row = 0;
+  }
+}
+
+uint32_t FrameGovernor::overruns() const {
+  uint32_t total = 0;
+  for (uint8_t level = 0; level < QUALITY_LEVELS; level++) {
+    total += _overruns[level];
+  }
+  return total;
+}
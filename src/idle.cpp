@@ -0,0 +1,63 @@
+/*
+File: idle.cpp
+Idle state of the main loop while the room is empty.
+*/
+#include "idle.h"
+
+IdleMonitor::IdleMonitor(uint32_t timeout_ms)
+  : _timeout_ms(timeout_ms),
+    _is_idle(false),
+    _is_empty(false),
+    _empty_since_ms(0),
+    _idle_since_ms(0),
+    _is_waking(false),
+    _wake_us(0),
+    _idle_ms(0),
+    _sleep_us(0),
+    _idle_entries(0),
+    _wake_to_light() {
+}
+
+void IdleMonitor::frame(bool is_present, bool is_dark, uint32_t now_ms) {
+  if (is_present) {
+    _is_empty = false;
+    return;
+  }
+
+  if (!_is_empty) {
+    _is_empty = true;
+    _empty_since_ms = now_ms;
+  }
+
+  // Wait until the effects have faded the strip out
+  if (!_is_idle && _timeout_ms && is_dark && now_ms - _empty_since_ms >= _timeout_ms) {
+    _is_idle = true;
+    _is_waking = false;
+    _idle_since_ms = now_ms;
+    _idle_entries++;
+  }
+}
+
+void IdleMonitor::wake(uint32_t event_us, uint32_t now_ms) {
+  _is_empty = false;
+
+  if (!_is_idle) {
+    return;
+  }
+
+  _is_idle = false;
+  _idle_ms += now_ms - _idle_since_ms;
+  _is_waking = true;
+  _wake_us = event_us;
+}
+
+void IdleMonitor::lit(uint32_t now_us) {
+  if (_is_waking) {
+    _is_waking = false;
+    _wake_to_light.add(now_us - _wake_us);
+  }
+}
+
+uint32_t IdleMonitor::idle_ms(uint32_t now_ms) const {
+  return _idle_ms + (_is_idle ? now_ms - _idle_since_ms : 0);
+}
@@ -0,0 +1,20 @@
+/*
+File: latency_stats.cpp
+Count, min, max and running average of a time in microseconds.
+*/
+#include "latency_stats.h"
+
+void Latency_stats::add(uint32_t latency_us) {
+  if (count == 0) {
+    min_us = max_us = avg_us = latency_us;
+  } else {
+    if (latency_us < min_us) {
+      min_us = latency_us;
+    }
+    if (latency_us > max_us) {
+      max_us = latency_us;
+    }
+    avg_us = avg_us - (avg_us >> 3) + (latency_us >> 3);
+  }
+  count++;
+}
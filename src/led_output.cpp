@@ -0,0 +1,56 @@
+/*
+File: led_output.cpp
+LED output backends.
+*/
+#include "led_output.h"
+
+void Ws2812_encode(const uint8_t *grb, uint16_t count, uint32_t *words) {
+  while (count--) {
+    *words++ = (uint32_t)grb[0] << 24 | (uint32_t)grb[1] << 16 | (uint32_t)grb[2] << 8;
+    grb += 3;
+  }
+}
+
+Ws2812Output::Ws2812Output()
+  : _back(0),
+    _back_count(0),
+    _pending(false),
+    _start_us(0),
+    _wire_us(0) {
+}
+
+void Ws2812Output::submit(const uint8_t *grb, uint16_t count) {
+  if (count > LED_OUTPUT_MAX_LEDS) {
+    count = LED_OUTPUT_MAX_LEDS;
+  }
+
+  // The front buffer may be on the wire, the back buffer is free
+  if (_pending) {
+    _stats.dropped++;
+  }
+  Ws2812_encode(grb, count, _buffers[_back]);
+  _back_count = count;
+  _pending = true;
+  _stats.submits++;
+
+  service();
+}
+
+void Ws2812Output::service() {
+  if (_pending && !_transmitting()) {
+    _swap_and_send();
+  }
+}
+
+void Ws2812Output::_swap_and_send() {
+  const uint32_t *front = _buffers[_back];
+  uint16_t count = _back_count;
+
+  _back ^= 1;
+  _pending = false;
+
+  _start_us = _now_us();
+  _wire_us = (uint32_t)count * WS2812_LED_US + WS2812_RESET_US;
+  _transmit(front, count);
+  _stats.frames++;
+}
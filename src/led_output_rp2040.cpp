@@ -0,0 +1,96 @@
+/*
+File: led_output_rp2040.cpp
+WS2812 output of the RP2040 with PIO and DMA.
+*/
+#if defined(ARDUINO_ARCH_RP2040)
+
+#include <Arduino.h>
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include "led_output_rp2040.h"
+
+// ws2812 program of the pico-examples, T1 = 2, T2 = 5, T3 = 3 cycles
+#define WS2812_T1 2
+#define WS2812_T2 5
+#define WS2812_T3 3
+#define WS2812_FREQ 800000
+
+static const uint16_t ws2812_program_instructions[] = {
+  //     .wrap_target
+  0x6221,  //  0: out    x, 1           side 0 [2]
+  0x1123,  //  1: jmp    !x, 3          side 1 [1]
+  0x1400,  //  2: jmp    0              side 1 [4]
+  0xa442,  //  3: nop                   side 0 [4]
+  //     .wrap
+};
+
+static const struct pio_program ws2812_program = {
+  ws2812_program_instructions,
+  sizeof(ws2812_program_instructions) / sizeof(ws2812_program_instructions[0]),
+  -1,  // origin: anywhere
+};
+
+Rp2040PioOutput::Rp2040PioOutput(uint8_t pin, PIO pio)
+  : _pin(pin),
+    _pio(pio),
+    _sm(-1),
+    _dma(-1) {
+}
+
+bool Rp2040PioOutput::begin() {
+  if (!pio_can_add_program(_pio, &ws2812_program)) {
+    return false;
+  }
+
+  _sm = pio_claim_unused_sm(_pio, false);
+  if (_sm < 0) {
+    return false;
+  }
+
+  _dma = dma_claim_unused_channel(false);
+  if (_dma < 0) {
+    pio_sm_unclaim(_pio, _sm);
+    return false;
+  }
+
+  uint offset = pio_add_program(_pio, &ws2812_program);
+
+  pio_gpio_init(_pio, _pin);
+  pio_sm_set_consecutive_pindirs(_pio, _sm, _pin, 1, true);
+
+  pio_sm_config config = pio_get_default_sm_config();
+  sm_config_set_wrap(&config, offset, offset + 3);
+  sm_config_set_sideset(&config, 1, false, false);
+  sm_config_set_sideset_pins(&config, _pin);
+  sm_config_set_out_shift(&config, false, true, 24);  // shift left, autopull 24 bits
+  sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_TX);
+
+  int cycles_per_bit = WS2812_T1 + WS2812_T2 + WS2812_T3;
+  sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / (WS2812_FREQ * cycles_per_bit));
+
+  pio_sm_init(_pio, _sm, offset, &config);
+  pio_sm_set_enabled(_pio, _sm, true);
+
+  // 32 bit words from memory to the TX FIFO, paced by the state machine
+  dma_channel_config dma_config = dma_channel_get_default_config(_dma);
+  channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_32);
+  channel_config_set_read_increment(&dma_config, true);
+  channel_config_set_write_increment(&dma_config, false);
+  channel_config_set_dreq(&dma_config, pio_get_dreq(_pio, _sm, true));
+  dma_channel_configure(_dma, &dma_config, &_pio->txf[_sm], NULL, 0, false);
+
+  return true;
+}
+
+void Rp2040PioOutput::_transmit(const uint32_t *words, uint16_t count) {
+  if (_dma < 0) {
+    return;
+  }
+  dma_channel_transfer_from_buffer_now(_dma, words, count);
+}
+
+uint32_t Rp2040PioOutput::_now_us() {
+  return micros();
+}
+
+#endif  // ARDUINO_ARCH_RP2040
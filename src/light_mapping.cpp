@@ -0,0 +1,166 @@
+/*
+File: light_mapping.cpp
+Continuous light parameters from the radar data.
+*/
+#include "light_mapping.h"
+
+#include <string.h>
+
+// Hue of the far end: blue
+#define LIGHT_MAPPING_HUE_FAR 170
+
+// Moving target light is wider by up to this many pixels at 100 % energy
+#define LIGHT_MAPPING_MOVING_SPREAD 8
+#define LIGHT_MAPPING_MIN_SPREAD    2
+
+LightMapper::LightMapper(uint16_t num_leds, uint16_t max_distance_cm, uint16_t smoothing_ms)
+  : _num_leds(num_leds < LIGHT_MAPPING_MAX_LEDS ? num_leds : LIGHT_MAPPING_MAX_LEDS),
+    _max_distance_cm(max_distance_cm ? max_distance_cm : 1),
+    _smoothing_ms(smoothing_ms) {
+  memset(&_target, 0, sizeof(_target));
+  memset(&_params, 0, sizeof(_params));
+  memset(_weights, 0, sizeof(_weights));
+
+  // Gates are spread evenly over the strip, a pixel between two gate
+  // centers gets both weights linear to the distance
+  uint32_t last = _num_leds > 1 ? _num_leds - 1 : 1;
+  for (uint16_t pixel = 0; pixel < _num_leds; pixel++) {
+    uint32_t pos = (uint32_t)pixel * (LIGHT_MAPPING_GATES - 1) * 256 / last;  // gate << 8
+    uint8_t gate = pos >> 8;
+    uint16_t frac = pos & 0xFF;
+
+    _weights[pixel][gate] = 255 - frac;
+    if (gate + 1 < LIGHT_MAPPING_GATES) {
+      _weights[pixel][gate + 1] = frac;
+    }
+  }
+}
+
+void LightMapper::set_target(uint8_t target_state,
+                             uint16_t moving_distance, uint8_t moving_energy,
+                             uint16_t stationary_distance, uint8_t stationary_energy,
+                             const uint8_t *moving_gates, const uint8_t *stationary_gates) {
+  bool is_moving = target_state & 0x01;
+  bool is_stationary = target_state & 0x02;
+
+  // The stronger target leads
+  uint16_t distance = 0;
+  uint8_t energy = 0;
+  if (is_moving && (!is_stationary || moving_energy >= stationary_energy)) {
+    distance = moving_distance;
+    energy = moving_energy;
+  } else if (is_stationary) {
+    distance = stationary_distance;
+    energy = stationary_energy;
+  }
+
+  if (distance > _max_distance_cm) {
+    distance = _max_distance_cm;
+  }
+  if (energy > 100) {
+    energy = 100;
+  }
+
+  // Without a target only the brightness changes, the light fades out in place
+  if (target_state) {
+    _target.hue = (uint32_t)distance * LIGHT_MAPPING_HUE_FAR * 256 / _max_distance_cm;
+    _target.position = (uint32_t)distance * (_num_leds - 1) * 256 / _max_distance_cm;
+
+    uint16_t spread = LIGHT_MAPPING_MIN_SPREAD;
+    if (is_moving) {
+      spread += (uint16_t)moving_energy * LIGHT_MAPPING_MOVING_SPREAD / 100;
+    }
+    _target.spread = spread << 8;
+  }
+  _target.brightness = target_state ? (uint16_t)energy * 255 * 256 / 100 : 0;
+
+  for (uint8_t gate = 0; gate < LIGHT_MAPPING_GATES; gate++) {
+    uint8_t gate_energy = 0;
+    if (moving_gates && stationary_gates) {
+      gate_energy = moving_gates[gate] > stationary_gates[gate] ? moving_gates[gate] : stationary_gates[gate];
+    }
+    if (gate_energy > 100) {
+      gate_energy = 100;
+    }
+    _target.gate[gate] = (uint16_t)gate_energy * 255 * 256 / 100;
+  }
+}
+
+// value += (target - value) * alpha, alpha Q16
+static void Smooth(uint16_t &value, uint16_t target, uint32_t alpha) {
+  int32_t diff = (int32_t)target - (int32_t)value;
+  int32_t step = (int32_t)(((int64_t)diff * alpha) >> 16);
+  if (step == 0 && diff != 0) {
+    step = diff > 0 ? 1 : -1;  // don't get stuck just below the target
+  }
+  value += step;
+}
+
+void LightMapper::update(uint32_t dt_ms) {
+  // alpha = dt / (smoothing + dt), independent of the render rate
+  if (dt_ms == 0) {
+    return;
+  }
+  uint32_t alpha = (uint32_t)(((uint64_t)dt_ms << 16) / (_smoothing_ms + dt_ms));
+
+  Smooth(_params.hue, _target.hue, alpha);
+  Smooth(_params.brightness, _target.brightness, alpha);
+  Smooth(_params.position, _target.position, alpha);
+  Smooth(_params.spread, _target.spread, alpha);
+  for (uint8_t gate = 0; gate < LIGHT_MAPPING_GATES; gate++) {
+    Smooth(_params.gate[gate], _target.gate[gate], alpha);
+  }
+}
+
+void LightMapper::map(uint8_t *rgb) const {
+  // Hue to a full color, like Wheel() in main.cpp but red to blue
+  uint8_t hue = _params.hue >> 8;
+  uint8_t r, g, b;
+  if (hue < 85) {
+    r = 255 - hue * 3;
+    g = hue * 3;
+    b = 0;
+  } else {
+    hue -= 85;
+    r = 0;
+    g = 255 - hue * 3;
+    b = hue * 3;
+  }
+
+  uint8_t gate[LIGHT_MAPPING_GATES];
+  for (uint8_t n = 0; n < LIGHT_MAPPING_GATES; n++) {
+    gate[n] = _params.gate[n] >> 8;
+  }
+
+  uint32_t brightness = _params.brightness >> 8;
+  int32_t position = _params.position;
+  int32_t spread = _params.spread > 256 ? _params.spread : 256;
+  uint32_t falloff = (255UL << 16) / spread;  // no division per pixel
+
+  for (uint16_t pixel = 0; pixel < _num_leds; pixel++) {
+    // Gate energy field
+    const uint8_t *weight = _weights[pixel];
+    uint32_t field = 0;
+    for (uint8_t n = 0; n < LIGHT_MAPPING_GATES; n++) {
+      field += weight[n] * gate[n];
+    }
+    field >>= 8;
+
+    // Target light, falls off linear to spread pixels from the position
+    int32_t distance = ((int32_t)pixel << 8) - position;
+    if (distance < 0) {
+      distance = -distance;
+    }
+    uint32_t level = distance < spread ? 255 - ((uint32_t)distance * falloff >> 16) : 0;
+
+    if (field > level) {
+      level = field;
+    }
+    level = level * brightness >> 8;
+
+    rgb[0] = r * level >> 8;
+    rgb[1] = g * level >> 8;
+    rgb[2] = b * level >> 8;
+    rgb += 3;
+  }
+}
@@ -12,13 +12,30 @@ Hardware:
 Pins:
 Pico GPIO0 (TX) -> Radar RX
 Pico GPIO1 (RX) -> Radar TX
+Pico GPIO2      -> Radar OUT
 Pico VBUS (5V)  -> Radar VCC
 Pico GND        -> Radar GND
 */
 
 #include <Arduino.h>
 #include "LD2410.h"             // https://github.com/Renstec/LD2410/
+#include "LD2410BackgroundModel.h"
+#include "latency_stats.h"
+#include "presence.h"
+#include "governor.h"
+#include "clip.h"
+#include "radar_history.h"
+#include "light_mapping.h"
+#include "led_output.h"
+#include "led_output_neopixel.h"
+#include "led_output_rp2040.h"
+#include "idle.h"
+#include "clip_comet.h"
+#include "clip_breathe.h"
 #include <Adafruit_NeoPixel.h>  // https://github.com/adafruit/Adafruit_NeoPixel/blob/master/examples/strandtest_nodelay/strandtest_nodelay.ino
+#if defined(ARDUINO_ARCH_RP2040)
+#include <hardware/sync.h>  // __wfi()
+#endif
 
 //#define DEBUG
 #include "utils_debug.h"
@@ -27,6 +44,7 @@ Pico GND        -> Radar GND
 #define USB_BAUD   115200
 
 #define TO_RADAR_RESET 0  // 0 no, 1 yes
+#define CLIP_BENCHMARK 0  // 0 no, 1 yes
 
 // Ring 49 LEDs, Ruut 59 LEDS
 #define RING 49
@@ -37,6 +55,13 @@ Pico GND        -> Radar GND
 #define BACKWARD   1
 #define RGB_DELAY 70  // smaller = faster
 
+// LED frame time budget, the reserve is kept free for radar.read()
+#define RENDER_PERIOD_US      20000
+#define RADAR_READ_RESERVE_US 2000
+
+// No target for this long and the strip dark: stop rendering and sleep
+#define IDLE_TIMEOUT_MS 30000  // 0 never
+
 // Pins:
 //const int RADAR_RX_PIN = 4;  // Pico default TX pin is GP0
 //const int RADAR_TX_PIN = 5;  // Pico default RX pin is GP1
@@ -48,6 +73,10 @@ const int RANDOM_SEED_ANALOG_PIN = 26;  // GP26
 const int NUM_OF_LEDS = KUJU;
 const int BRIGHTNESS = 75;  // 0-255
 
+// A longer strip would be cut short at run time, fail here instead
+static_assert(NUM_OF_LEDS <= LED_OUTPUT_MAX_LEDS, "raise LED_OUTPUT_MAX_LEDS in led_output.h");
+static_assert(NUM_OF_LEDS <= LIGHT_MAPPING_MAX_LEDS, "raise LIGHT_MAPPING_MAX_LEDS in light_mapping.h");
+
 int rgb_R = 0;
 int rgb_G = 0;
 int rgb_B = 0;
@@ -60,11 +89,80 @@ int      pixel_cycle = 0;      // Pattern Pixel Cycle
 // Init RGB strip
 Adafruit_NeoPixel RGB_strip(NUM_OF_LEDS, RGB_IN_PIN, NEO_GRB + NEO_KHZ800);
 
+// LED output: the effects draw into RGB_strip, Led_show() sends its pixels.
+// On the Pico PIO + DMA send the frame while the CPU goes on,
+// elsewhere (simulation) show() blocks.
+#if defined(ARDUINO_ARCH_RP2040)
+Rp2040PioOutput led_output(RGB_IN_PIN);
+#else
+NeoPixelOutput led_output(RGB_strip);
+#endif
+bool is_led_output_ready = false;  // Else RGB_strip.show() sends the pixels
+Latency_stats led_submit;  // CPU time per frame
+
+// Sleep while the room is empty, wake on radar UART RX or the OUT pin
+IdleMonitor idle(IDLE_TIMEOUT_MS);
+
 // Init Radar
 LD2410 radar(Serial1);
 
 bool is_radar_eng_mode = false;  // True enables Radar Enginering Mode
 
+// True learns the empty room and sets the gate sensitivities once
+bool is_radar_auto_calibration = false;
+bool is_radar_calibrated = false;
+
+// Auto calibration needs the Engineering mode data and the config commands
+#define RADAR_AUTO_CALIBRATION (LD2410_ENGINEERING_MODE && LD2410_CONFIG_COMMANDS)
+
+#if RADAR_AUTO_CALIBRATION
+// Background energy model of the empty room
+LD2410BackgroundModel radar_background;
+#endif
+
+// Radar OUT pin, set in interrupt
+volatile bool     radar_out_changed = false;
+volatile bool     radar_out_level = false;
+volatile uint32_t radar_out_edge_us = 0;
+
+// OUT pin vs. UART frames
+PresenceArbiter presence;
+bool is_light_on = false;
+
+// Pin edge to light and UART frame to light latency
+Latency_stats pin_to_light;
+Latency_stats uart_to_light;
+
+// UART frame with a target while the light was off, waits for the first lit show()
+bool is_uart_light_pending = false;
+uint32_t uart_light_frame_us = 0;
+
+// Radar samples of the last 12.8 s, for trends
+RadarHistory<128> radar_history;
+#define HISTORY_SHORT 0  // window 2 s
+#define HISTORY_LONG  1  // window 10 s
+
+// Render cost per frame, lowers the effect quality if needed
+FrameGovernor governor(RENDER_PERIOD_US, RADAR_READ_RESERVE_US);
+
+// Radar frame read while an effect was waiting
+bool is_radar_frame_pending = false;
+
+// True plays the animation clips instead of the computed effects
+bool is_clip_mode = false;
+ClipPlayer clip_player;
+
+// True maps the radar distance and energies to a continuous light
+// instead of the effects
+bool is_light_mapping = false;
+LightMapper light_mapper(NUM_OF_LEDS);
+uint32_t light_mapping_us = 0;  // last render
+uint8_t light_mapping_rgb[NUM_OF_LEDS * 3];
+
+// Clip per radar target state: no target, moving, stationary, both.
+// No clip: wipe the LEDs off.
+const uint8_t *const target_clips[4] = {nullptr, CLIP_COMET, CLIP_BREATHE, CLIP_COMET};
+
 bool is_first_loop = true;
 
 // Input: 0 to 255 to get a color value.
@@ -86,6 +184,39 @@ uint32_t Wheel(uint8_t wheel_pos) {
   return RGB_strip.Color(wheel_pos * 3, 255 - wheel_pos * 3, 0);
 }
 
+// All pixels of RGB_strip off
+bool Led_is_dark() {
+  const uint8_t *pixels = RGB_strip.getPixels();
+
+  for (uint16_t i = 0; i < NUM_OF_LEDS * 3; i++) {
+    if (pixels[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Send the pixels of RGB_strip
+void Led_show() {
+  uint32_t start_us = micros();
+  if (is_led_output_ready) {
+    led_output.submit(RGB_strip.getPixels(), NUM_OF_LEDS);
+  } else {
+    RGB_strip.show();
+  }
+  led_submit.add(micros() - start_us);
+
+  if ((idle.waking() || is_uart_light_pending) && !Led_is_dark()) {
+    idle.lit(micros());
+
+    if (is_uart_light_pending) {
+      is_uart_light_pending = false;
+      uart_to_light.add(micros() - uart_light_frame_us);
+      DEBUG_PRINT("UART frame to light us: ");
+      DEBUG_PRINTLN(micros() - uart_light_frame_us);
+    }
+  }
+}
 
 // Fill strip pixels one after another with a color.
 // Strip is NOT cleared; anything there will be covered pixel by pixel. 
@@ -97,29 +228,77 @@ void Rgb_color_wipe(uint32_t color, int wait, int dir = 0) {
       pixel_interval = wait;                   //  Update delay time
     }
 
-    RGB_strip.setPixelColor(pixel_current, color); //  Set pixel's color (in RAM)
-    RGB_strip.show();
-    pixel_current++;
+    uint32_t now_us = micros();
+    if (!governor.frame_due(now_us)) {
+      return;
+    }
+
+    governor.frame_start(now_us);
+    // Lower quality sets more pixels per step
+    for (uint8_t n = 0; n < governor.pixel_step(); n++) {
+      RGB_strip.setPixelColor(pixel_current, color); //  Set pixel's color (in RAM)
+      pixel_current++;
+
+      if(pixel_current >= NUM_OF_LEDS) {
+        pixel_current = 0;                               //  Loop the pattern from the first LED
+      }
+    }
+    Led_show();
+    governor.frame_end(micros());
+  }
+}
+
+void Radar_out_fast_path();
+
+// Add the radar frame just read to the history and the presence arbiter.
+// Returns true if a target is present.
+bool Radar_record_frame() {
+  radar_history.add({(uint32_t)millis(),
+                     radar.cyclicData.movingTargetDistance,
+                     radar.cyclicData.stationaryTargetDistance,
+                     radar.cyclicData.targetState,
+                     radar.cyclicData.movingTargetEnergy,
+                     radar.cyclicData.stationaryTargetEnergy});
+  return presence.uart_frame(radar.cyclicData.targetState, millis());
+}
+
+// Wait, but keep reading the radar so its frames don't pile up in the UART,
+// and handle the OUT pin. Every frame goes to the history, loop() handles
+// the last one after the effect.
+void Radar_wait(uint32_t wait_ms) {
+  uint32_t start_ms = millis();
 
-    if(pixel_current >= NUM_OF_LEDS) {
-      pixel_current = 0;                               //  Loop the pattern from the first LED
+  while (millis() - start_ms < wait_ms) {
+    if (radar.read()) {
+      Radar_record_frame();
+      is_radar_frame_pending = true;
     }
+    Radar_out_fast_path();
+    delay(1);
   }
 }
 
 void Rgb_color_wipe_delay(uint32_t color, int wait, int dir = 0) {
+  // Lower quality sets more pixels per step, the wipe takes as long
+  int step = governor.pixel_step();
+
   if (dir == FORWARD) {
-    for(int i=0; i<RGB_strip.numPixels(); i++) {
-      RGB_strip.setPixelColor(i, color);
-      RGB_strip.show();
-      delay(wait);
+    for(int i=0; i<RGB_strip.numPixels(); i+=step) {
+      governor.frame_start(micros());
+      RGB_strip.fill(color, i, step);
+      Led_show();
+      governor.frame_end(micros());
+      Radar_wait(wait * step);
     }
   } else {
     // Backward
-    for(int i=RGB_strip.numPixels(); i>=0; i--) {
-      RGB_strip.setPixelColor(i, color);
-      RGB_strip.show();
-      delay(wait);
+    for(int i=RGB_strip.numPixels(); i>=0; i-=step) {
+      int first = i - step + 1 < 0 ? 0 : i - step + 1;
+      governor.frame_start(micros());
+      RGB_strip.fill(color, first, i - first + 1);
+      Led_show();
+      governor.frame_end(micros());
+      Radar_wait(wait * step);
     }
   }
   
@@ -134,11 +313,15 @@ void Rainbow(uint8_t wait) {
     pixel_interval = wait;
   }
 
-  for(uint16_t i=0; i < NUM_OF_LEDS; i++) {
-    RGB_strip.setPixelColor(i, Wheel((i + pixel_cycle) & 255)); //  Update delay time
+  governor.frame_start(micros());
+  // Lower quality: one color per group of pixels
+  uint8_t step = governor.pixel_step();
+  for(uint16_t i=0; i < NUM_OF_LEDS; i+=step) {
+    RGB_strip.fill(Wheel((i + pixel_cycle) & 255), i, step); //  Update delay time
   }
 
-  RGB_strip.show();
+  Led_show();
+  governor.frame_end(micros());
   pixel_cycle++;            //  Advance current cycle
 
   if(pixel_cycle >= 256) {
@@ -149,6 +332,159 @@ void Rainbow(uint8_t wait) {
 
 
 
+// Radar OUT pin changed
+void Radar_out_isr() {
+  radar_out_edge_us = micros();
+  radar_out_level = digitalRead(RADAR_OUT_PIN);
+  radar_out_changed = true;
+}
+
+// Fill all pixels with one color and show at once
+void Rgb_fill(uint32_t color) {
+  governor.frame_start(micros());
+  RGB_strip.fill(color);
+  Led_show();
+  governor.frame_end(micros());
+}
+
+// Fast path: light on as soon as the radar OUT pin rises
+void Radar_out_fast_path() {
+  if (!radar_out_changed) {
+    return;
+  }
+
+  noInterrupts();
+  bool level = radar_out_level;
+  uint32_t edge_us = radar_out_edge_us;
+  radar_out_changed = false;
+  interrupts();
+
+  // Time of the edge, the pin may be handled late
+  uint32_t edge_ms = millis() - (micros() - edge_us) / 1000;
+
+  bool is_target = presence.pin_edge(level, edge_ms);
+  if (is_target) {
+    idle.wake(edge_us, millis());
+  }
+
+  // The light mapping fades in and the clip starts at a keyframe from the
+  // next radar frame, a fill would be overwritten by their deltas
+  if (is_target && !is_light_mapping && !is_clip_mode) {
+    rgb_R = random(0, 255);
+    rgb_G = random(0, 255);
+    rgb_B = random(0, 255);
+    Rgb_fill(RGB_strip.Color(rgb_R, rgb_G, rgb_B));
+    is_light_on = true;
+    pin_to_light.add(micros() - edge_us);
+    DEBUG_PRINT("OUT pin to light us: ");
+    DEBUG_PRINTLN(micros() - edge_us);
+  }
+}
+
+// Start the clip of the target state, keep playing if it already runs
+void Clip_select(uint8_t target_state) {
+  const uint8_t *clip = target_clips[target_state & 0x03];
+
+  if (!clip) {
+    clip_player.stop();
+    Rgb_color_wipe(RGB_strip.Color(0, 0, 0), RGB_DELAY); // LEDs off
+  } else if (clip_player.clip() != clip) {
+    clip_player.start(clip, true, millis());
+  }
+}
+
+// Show the next clip frame when it is due. Lower quality shows fewer
+// frames, the player decodes the skipped deltas.
+void Clip_play() {
+  uint32_t now_us = micros();
+  if (!governor.frame_due(now_us)) {
+    return;
+  }
+
+  governor.frame_start(now_us);
+  if (clip_player.update(RGB_strip, millis())) {
+    Led_show();
+    governor.frame_end(micros());
+  }
+}
+
+// New radar frame for the light mapping
+void Light_mapping_input(uint8_t target_state) {
+  const uint8_t *moving_gates = nullptr;
+  const uint8_t *stationary_gates = nullptr;
+
+#if LD2410_ENGINEERING_MODE
+  if (radar.cyclicData.radarInEngineeringMode) {
+    moving_gates = radar.engineeringData.movingEnergyGateN;
+    stationary_gates = radar.engineeringData.stationaryEnergyGateN;
+  }
+#endif
+
+  light_mapper.set_target(target_state,
+                          radar.cyclicData.movingTargetDistance, radar.cyclicData.movingTargetEnergy,
+                          radar.cyclicData.stationaryTargetDistance, radar.cyclicData.stationaryTargetEnergy,
+                          moving_gates, stationary_gates);
+}
+
+// Continuous light at the render rate, also between the radar frames
+void Light_mapping_render() {
+  uint32_t now_us = micros();
+  if (!governor.frame_due(now_us)) {
+    return;
+  }
+  uint32_t dt_ms = (now_us - light_mapping_us) / 1000;
+  light_mapping_us = now_us;
+
+  governor.frame_start(now_us);
+  light_mapper.update(dt_ms);
+  light_mapper.map(light_mapping_rgb);
+  for (uint16_t i = 0; i < NUM_OF_LEDS; i++) {
+    const uint8_t *rgb = &light_mapping_rgb[i * 3];
+    RGB_strip.setPixelColor(i, rgb[0], rgb[1], rgb[2]);
+  }
+  Led_show();
+  governor.frame_end(micros());
+}
+
+// Sleep until the next interrupt: radar UART RX, OUT pin, timers
+void Idle_sleep() {
+  uint32_t start_us = micros();
+
+  // An interrupt between the check and __wfi() still wakes it
+  noInterrupts();
+  if (!Serial1.available() && !radar_out_changed) {
+    __wfi();
+  }
+  interrupts();
+
+  idle.slept(micros() - start_us);
+}
+
+#if CLIP_BENCHMARK
+// Decode cost of a clip, without show()
+void Clip_benchmark(const uint8_t *clip, const char *name) {
+  const uint8_t rounds = 10;
+  ClipPlayer player;
+  uint32_t frames = 0;
+
+  uint32_t start_us = micros();
+  for (uint8_t i = 0; i < rounds; i++) {
+    player.start(clip, false, 0);
+    while (player.decode_frame(RGB_strip)) {
+      frames++;
+    }
+  }
+  uint32_t total_us = micros() - start_us;
+
+  Serial.print("Clip ");
+  Serial.print(name);
+  Serial.print(": us per frame ");
+  Serial.print((float)total_us / frames);
+  Serial.print(", ns per LED ");
+  Serial.println((float)total_us * 1000 / frames / player.led_count());
+}
+#endif
+
 void setup() {
   // Start USB serial print
   Serial.begin(USB_BAUD);
@@ -161,6 +497,7 @@ void setup() {
   DEBUG_PRINTLN("Art Light started!");
   delay(1000);
 
+#if LD2410_CONFIG_COMMANDS
   if (TO_RADAR_RESET) {
     // Restore radar default values
     bool is_radar_factory_reset = radar.factoryReset();
@@ -184,7 +521,9 @@ void setup() {
     // Restart radar
     bool is_radar_restart = radar.restart();
   }
+#endif
 
+#if LD2410_READ_COMMANDS
   Serial.print("Connecting to radar .");
   while (!radar.begin()) {
     DEBUG_PRINT(".");
@@ -225,17 +564,39 @@ void setup() {
   } else {
     DEBUG_PRINTLN("Failed to get firmware version and parameters from radar.");
   }
+#endif
 
+#if LD2410_CONFIG_COMMANDS
   // Enable or disable Radar Engineering mode
-  radar.enableEngMode(is_radar_eng_mode);
+  // Auto calibration needs the energy per gate from the Engineering mode
+  radar.enableEngMode(is_radar_eng_mode || is_radar_auto_calibration);
+#endif
 
   // RGB strip
   
   RGB_strip.begin();
-  RGB_strip.show();  // Turn OFF all pixels ASAP
+  is_led_output_ready = led_output.begin();
+  if (!is_led_output_ready) {
+    DEBUG_PRINTLN("No PIO state machine or DMA channel for the LEDs, using show().");
+  }
+  Led_show();  // Turn OFF all pixels ASAP
   RGB_strip.setBrightness(BRIGHTNESS);
+
+#if CLIP_BENCHMARK
+  Clip_benchmark(CLIP_COMET, "comet");
+  Clip_benchmark(CLIP_BREATHE, "breathe");
+  RGB_strip.clear();
+#endif
  
   randomSeed(analogRead(RANDOM_SEED_ANALOG_PIN));
+
+  radar_history.set_window(HISTORY_SHORT, 2000);
+  radar_history.set_window(HISTORY_LONG, 10000);
+
+  // Radar OUT pin is high while a target is detected
+  pinMode(RADAR_OUT_PIN, INPUT);
+  radar_out_level = digitalRead(RADAR_OUT_PIN);
+  attachInterrupt(digitalPinToInterrupt(RADAR_OUT_PIN), Radar_out_isr, CHANGE);
   
   DEBUG_PRINTLN("Setup finished!");
 }
@@ -259,38 +620,110 @@ void loop() {
   RGB_strip.show();   // Send the updated pixel colors to the hardware.
   */
   
+  Radar_out_fast_path();
+
+  if (idle.idle()) {
+    Idle_sleep();
+  }
+
+  // Start a frame which waited for the previous one
+  led_output.service();
+
+  if (idle.idle()) {
+    // Nothing to render
+  } else if (is_clip_mode) {
+    Clip_play();
+  } else if (is_light_mapping) {
+    Light_mapping_render();
+  }
+
   // read must be called cyclically
-  if (radar.read()) {
+  bool is_radar_frame = radar.read();
+  if (is_radar_frame || is_radar_frame_pending) {
+    is_radar_frame_pending = false;
+    uint32_t frame_us = micros();
+#if RADAR_AUTO_CALIBRATION
+    // Learn the empty room, then set all gate sensitivities at once
+    if (is_radar_auto_calibration && !is_radar_calibrated) {
+      radar_background.update(radar);
+
+      if (radar_background.isReady()) {
+        is_radar_calibrated = radar_background.apply(radar);
+
+        if (is_radar_calibrated) {
+          DEBUG_PRINTLN("Radar gate sensitivities calibrated");
+          radar.enableEngMode(is_radar_eng_mode);
+        } else {
+          radar_background.reset();
+        }
+      }
+    }
+#endif
+
     // Cyclic radar data
     DEBUG_PRINT("\nTarget state: ");
     DEBUG_PRINT(radar.cyclicData.targetState);
 
-    switch (radar.cyclicData.targetState) {
-      case 0x00:
-        DEBUG_PRINTLN(" no target detected");
-        Rgb_color_wipe(RGB_strip.Color(0, 0, 0), RGB_DELAY); // LEDs off
-        break;
-      case 0x01:
-        DEBUG_PRINTLN(" moving target detected");
-        rgb_R = random(0, 255);
-        rgb_G = random(0, 255);
-        rgb_B = random(0, 255);
-        Rgb_color_wipe_delay(RGB_strip.Color(rgb_R, rgb_G, rgb_B), RGB_DELAY, BACKWARD);
-        //Rainbow(RGB_DELAY);
-        break;
-      case 0x02:
-        DEBUG_PRINTLN(" stationary target detected");
-        Rgb_color_wipe(RGB_strip.Color(rgb_R, rgb_G, rgb_B), RGB_DELAY);
-        //Rainbow(RGB_DELAY);
-        break;
-      case 0x03:
-        DEBUG_PRINTLN(" moving and stationary target detected");
-        rgb_R = random(0, 255);
-        rgb_G = random(0, 255);
-        rgb_B = random(0, 255);
-        Rgb_color_wipe_delay(RGB_strip.Color(rgb_R, rgb_G, rgb_B), RGB_DELAY, BACKWARD);
-        // Rainbow(RGB_DELAY);
-        break;
+    // UART frame takes over from the OUT pin
+    uint8_t target_state = radar.cyclicData.targetState;
+
+    // A frame read by Radar_wait() is recorded already
+    bool is_present = is_radar_frame ? Radar_record_frame() : presence.present(millis());
+
+    if (target_state == 0x00 && is_present) {
+      // OUT pin is high, the frame is older than the detection
+      target_state = 0x02;
+    }
+
+    // Unless the fast path was first, the effect below switches the light on.
+    // Led_show() takes the latency at the first lit frame.
+    if (!is_present) {
+      is_uart_light_pending = false;
+    } else if (!is_light_on) {
+      is_uart_light_pending = true;
+      uart_light_frame_us = frame_us;
+    }
+    is_light_on = is_present;
+
+    if (is_present) {
+      idle.wake(frame_us, millis());
+    }
+    idle.frame(is_present, Led_is_dark() && !(is_led_output_ready && led_output.busy()), millis());
+
+    if (idle.idle()) {
+      // The strip is dark already
+    } else if (is_clip_mode) {
+      Clip_select(target_state);
+    } else if (is_light_mapping) {
+      Light_mapping_input(target_state);
+    } else {
+      switch (target_state) {
+        case 0x00:
+          DEBUG_PRINTLN(" no target detected");
+          Rgb_color_wipe(RGB_strip.Color(0, 0, 0), RGB_DELAY); // LEDs off
+          break;
+        case 0x01:
+          DEBUG_PRINTLN(" moving target detected");
+          rgb_R = random(0, 255);
+          rgb_G = random(0, 255);
+          rgb_B = random(0, 255);
+          Rgb_color_wipe_delay(RGB_strip.Color(rgb_R, rgb_G, rgb_B), RGB_DELAY, BACKWARD);
+          //Rainbow(RGB_DELAY);
+          break;
+        case 0x02:
+          DEBUG_PRINTLN(" stationary target detected");
+          Rgb_color_wipe(RGB_strip.Color(rgb_R, rgb_G, rgb_B), RGB_DELAY);
+          //Rainbow(RGB_DELAY);
+          break;
+        case 0x03:
+          DEBUG_PRINTLN(" moving and stationary target detected");
+          rgb_R = random(0, 255);
+          rgb_G = random(0, 255);
+          rgb_B = random(0, 255);
+          Rgb_color_wipe_delay(RGB_strip.Color(rgb_R, rgb_G, rgb_B), RGB_DELAY, BACKWARD);
+          // Rainbow(RGB_DELAY);
+          break;
+      }
     }
 
     DEBUG_PRINT("Moving taget distance in cm: ");
@@ -308,6 +741,41 @@ void loop() {
     DEBUG_PRINT("Detection distance in cm: ");
     DEBUG_PRINTLN(radar.cyclicData.detectionDistance);
 
+    DEBUG_PRINT("Moving distance trend 2 s (<0 approaching): ");
+    DEBUG_PRINTLN(radar_history.trend(HISTORY_SHORT, METRIC_MOVING_DISTANCE));
+
+    DEBUG_PRINT("Moving energy 10 s avg/max: ");
+    DEBUG_PRINT(radar_history.average(HISTORY_LONG, METRIC_MOVING_ENERGY));
+    DEBUG_PRINT("/");
+    DEBUG_PRINTLN(radar_history.max(HISTORY_LONG, METRIC_MOVING_ENERGY));
+
+    DEBUG_PRINT("Dwell time ms: ");
+    DEBUG_PRINTLN(radar_history.dwell_ms(millis()));
+
+    DEBUG_PRINT("Render quality: ");
+    DEBUG_PRINT(governor.level());
+    DEBUG_PRINT(", overruns: ");
+    DEBUG_PRINT(governor.overruns());
+    DEBUG_PRINT(", cost us per frame/period: ");
+    DEBUG_PRINT(governor.cost().avg_us);
+    DEBUG_PRINT("/");
+    DEBUG_PRINTLN(governor.period_cost().avg_us);
+
+    DEBUG_PRINT("LED submit us avg/max: ");
+    DEBUG_PRINT(led_submit.avg_us);
+    DEBUG_PRINT("/");
+    DEBUG_PRINT(led_submit.max_us);
+    DEBUG_PRINT(", frames dropped: ");
+    DEBUG_PRINTLN(led_output.stats().dropped);
+
+    DEBUG_PRINT("Idle ms: ");
+    DEBUG_PRINT(idle.idle_ms(millis()));
+    DEBUG_PRINT(", idle entries: ");
+    DEBUG_PRINT(idle.idle_entries());
+    DEBUG_PRINT(", wake to light us: ");
+    DEBUG_PRINTLN(idle.wake_to_light().avg_us);
+
+#if LD2410_ENGINEERING_MODE
     // Engineering Mode data
     if (radar.cyclicData.radarInEngineeringMode) {
       DEBUG_PRINTLN("--Radar is in Engineering Mode--");
@@ -338,6 +806,7 @@ void loop() {
       }
       DEBUG_PRINTLN();
     }
+#endif
   } else {
     //Serial.println("No radar data.");
   }
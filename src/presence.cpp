@@ -0,0 +1,58 @@
+/*
+File: presence.cpp
+Arbitration between the radar OUT pin and the radar UART frames.
+*/
+#include "presence.h"
+
+PresenceArbiter::PresenceArbiter(uint32_t pin_hold_ms, uint32_t uart_timeout_ms)
+  : _pin_hold_ms(pin_hold_ms),
+    _uart_timeout_ms(uart_timeout_ms),
+    _pin_level(false),
+    _pin_rise_ms(0),
+    _uart_present(false),
+    _uart_seen(false),
+    _uart_frame_ms(0),
+    _disagreements(0) {
+}
+
+bool PresenceArbiter::pin_edge(bool level, uint32_t edge_ms) {
+  // Handled late, the UART frame after the edge knows better
+  bool is_stale = _uart_seen && (int32_t)(edge_ms - _uart_frame_ms) < 0;
+  bool was_present = present(edge_ms);
+
+  _pin_level = level;
+
+  if (level) {
+    _pin_rise_ms = edge_ms;
+    // Switch on at once, don't wait for the UART frame
+    return !was_present && !is_stale;
+  }
+
+  return false;
+}
+
+bool PresenceArbiter::uart_frame(uint8_t target_state, uint32_t now_ms) {
+  _uart_present = target_state != 0;  // 0 = no target
+  _uart_seen = true;
+  _uart_frame_ms = now_ms;
+
+  if (_uart_present != _pin_level) {
+    _disagreements++;
+  }
+
+  return present(now_ms);
+}
+
+bool PresenceArbiter::present(uint32_t now_ms) const {
+  // No UART frames, the pin decides alone
+  if (!_uart_seen || now_ms - _uart_frame_ms >= _uart_timeout_ms) {
+    return _pin_level;
+  }
+
+  if (_uart_present) {
+    return true;
+  }
+
+  // Pin high but UART no target: trust the pin shortly after the rising edge
+  return _pin_level && now_ms - _pin_rise_ms < _pin_hold_ms;
+}
@@ -0,0 +1,192 @@
+/*
+File: background_model_bench.cpp
+Host check and benchmark of the LD2410 background model
+(lib/LD2410/src/LD2410BackgroundModel.cpp): the fixed point EWMA and
+the isqrt() threshold against the same model in floating point, then
+the cost of update() and proposeThresholds().
+
+Builds against the Arduino shim of the simulation:
+
+  g++ -O2 -std=gnu++17 -Isim -Ilib/LD2410/src tools/background_model_bench.cpp \
+      lib/LD2410/src/LD2410BackgroundModel.cpp lib/LD2410/src/LD2410.cpp \
+      sim/sim_arduino.cpp sim/sim_radar.cpp -o background_model_bench
+  ./background_model_bench
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LD2410BackgroundModel.h"
+#include "sim.h"
+#include "bench.h"
+
+#define SHIFT 5  // default alpha 1/32
+
+Sim_stats sim_stats;  // used by the shim
+
+// Normal distribution, Box-Muller
+static double Gauss() {
+  double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+  return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static uint8_t Energy(double mean, double sigma) {
+  double value = round(mean + sigma * Gauss());
+  return value < 0 ? 0 : value > 100 ? 100 : (uint8_t)value;
+}
+
+// The same model in floating point
+struct Reference {
+  double mean[18];
+  double variance[18];
+  uint32_t frames;
+
+  void update(const uint8_t *values) {
+    for (uint8_t i = 0; i < 18; i++) {
+      if (frames == 0) {
+        mean[i] = values[i];
+        variance[i] = 0;
+      }
+      double delta = values[i] - mean[i];
+      mean[i] += delta / (1 << SHIFT);
+      variance[i] += (delta * delta - variance[i]) / (1 << SHIFT);
+    }
+    frames++;
+  }
+
+  double threshold(uint8_t i, uint8_t k, uint8_t margin) const {
+    double threshold = mean[i] + k * sqrt(variance[i]) + margin;
+    return threshold > 100 ? 100 : threshold;
+  }
+};
+
+static void Test_constant() {
+  LD2410BackgroundModel model(SHIFT);
+  uint8_t moving[9], stationary[9];
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    moving[gate] = gate * 10;
+    stationary[gate] = 100 - gate * 10;
+  }
+
+  for (uint32_t frame = 0; frame < (4UL << SHIFT) - 1; frame++) {
+    model.update(moving, stationary);
+  }
+  Check(!model.isReady(), "not ready before 4 time constants");
+  model.update(moving, stationary);
+  Check(model.isReady(), "ready after 4 time constants");
+
+  // No variance: mean + margin
+  uint8_t moving_threshold[9], stationary_threshold[9];
+  model.proposeThresholds(moving_threshold, stationary_threshold);
+  bool ok = true;
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    uint8_t expected = stationary[gate] + 5 > 100 ? 100 : stationary[gate] + 5;
+    ok &= moving_threshold[gate] == moving[gate] + 5 && stationary_threshold[gate] == expected;
+  }
+  Check(ok, "constant energy: mean + margin, clamped to 100");
+
+  model.setThresholdRule(0, 0);
+  model.proposeThresholds(moving_threshold, stationary_threshold);
+  Check(moving_threshold[4] == 40 && stationary_threshold[4] == 60, "k 0, margin 0: the mean");
+
+  // Values over 100 count as 100
+  uint8_t high[9] = {255, 255, 255, 255, 255, 255, 255, 255, 255};
+  model.reset();
+  for (uint32_t frame = 0; frame < 200; frame++) {
+    model.update(high, high);
+  }
+  model.proposeThresholds(moving_threshold, stationary_threshold);
+  Check(model.frames() == 200 && moving_threshold[0] == 100, "energy over 100 clamped");
+}
+
+static void Test_noise(uint8_t k, uint8_t margin) {
+  const double means[9] = {40, 30, 20, 15, 12, 10, 8, 8, 8};
+  const double sigmas[9] = {6, 5, 4, 3, 3, 2, 2, 1, 1};
+
+  LD2410BackgroundModel model(SHIFT);
+  model.setThresholdRule(k, margin);
+  Reference reference = {};
+
+  int max_error = 0;
+  for (uint32_t frame = 0; frame < 5000; frame++) {
+    uint8_t values[18];
+    for (uint8_t gate = 0; gate <= 8; gate++) {
+      values[gate] = Energy(means[gate], sigmas[gate]);
+      values[9 + gate] = Energy(means[gate] / 2, sigmas[gate]);
+    }
+    model.update(values, values + 9);
+    reference.update(values);
+
+    if (!model.isReady() || frame % 10) {
+      continue;
+    }
+
+    // Tracks the floating point model while the noise goes on
+    uint8_t thresholds[18];
+    model.proposeThresholds(thresholds, thresholds + 9);
+    for (uint8_t i = 0; i < 18; i++) {
+      int error = abs(thresholds[i] - (int)round(reference.threshold(i, k, margin)));
+      max_error = error > max_error ? error : max_error;
+    }
+  }
+
+  char what[80];
+  snprintf(what, sizeof(what), "noise, k %u margin %u: max error vs float %d %%", k, margin, max_error);
+  Check(max_error <= 1, what);
+
+  // Settled near mean + k * sigma + margin of the noise itself
+  uint8_t thresholds[18];
+  model.proposeThresholds(thresholds, thresholds + 9);
+  int max_deviation = 0;
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    int expected = (int)round(means[gate] + k * sigmas[gate] + margin);
+    int deviation = abs(thresholds[gate] - expected);
+    max_deviation = deviation > max_deviation ? deviation : max_deviation;
+  }
+  snprintf(what, sizeof(what), "noise, k %u margin %u: max deviation from the noise %d %%", k, margin,
+           max_deviation);
+  Check(max_deviation <= k * 2 + 1, what);
+}
+
+static void Bench() {
+  LD2410BackgroundModel model(SHIFT);
+  static uint8_t values[256][18];
+  for (uint16_t i = 0; i < 256; i++) {
+    for (uint8_t j = 0; j < 18; j++) {
+      values[i][j] = Energy(20, 5);
+    }
+  }
+
+  const uint32_t n = 1000000;
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    model.update(values[i & 255], values[i & 255] + 9);
+  }
+  double update_ns = (Now_ns() - start) / n;
+
+  uint8_t thresholds[18];
+  uint32_t checksum = 0;
+  start = Now_ns();
+  for (uint32_t i = 0; i < n / 10; i++) {
+    model.setThresholdRule(3, i & 7);
+    model.proposeThresholds(thresholds, thresholds + 9);
+    checksum += thresholds[i % 18];
+  }
+  double propose_ns = (Now_ns() - start) / (n / 10);
+
+  printf("update() %.1f ns per frame (18 gates), proposeThresholds() %.1f ns (checksum %u)\n", update_ns,
+         propose_ns, checksum);
+}
+
+int main() {
+  srand(1);
+
+  Test_constant();
+  Test_noise(3, 5);
+  Test_noise(2, 0);
+  printf("\n");
+
+  Bench();
+  return Check_result();
+}
@@ -0,0 +1,35 @@
+/*
+File: bench.h
+Shared part of the host checks and benchmarks in tools/, one program per
+*_bench.cpp, all built and run by tools/run_benches.sh.
+
+Check() prints one named result and counts the failures, the program
+returns Check_result(). Now_ns() is the clock for the timings.
+*/
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <time.h>
+
+static int check_failures = 0;
+
+static inline void Check(bool ok, const char *what) {
+  printf("%-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) {
+    check_failures++;
+  }
+}
+
+// Exit code of the program
+static inline int Check_result() {
+  return check_failures ? 1 : 0;
+}
+
+static inline double Now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#endif  // BENCH_H
@@ -0,0 +1,150 @@
+/*
+File: client_push_bench.cpp
+Host check of the per client push policy of the ESP32_WebConfig example
+(lib/LD2410/examples/ESP32_WebConfig/ClientPushPolicy.h) with simulated
+websocket clients: a 40 Hz frame producer, a fast client and a client
+whose send queue stays busy for 300 ms per message, like loop() of the
+example polls them every millisecond.
+
+  g++ -O2 -std=gnu++17 -Ilib/LD2410/examples/ESP32_WebConfig tools/client_push_bench.cpp -o client_push_bench
+  ./client_push_bench
+*/
+#include <stdio.h>
+
+#include "ClientPushPolicy.h"
+#include "bench.h"
+
+#define PUSH_INTERVAL_MS 50  // same as the example, 20 frames/s
+#define FRAME_MS         25  // 40 Hz producer
+#define RUN_MS           10000
+
+// Websocket client seen by loop(): queue busy for stall_ms after a message
+struct SimClient {
+  uint32_t id;
+  uint32_t stall_ms;
+  uint32_t busy_until;
+  uint32_t last_frame;     // sequence of the last frame sent to it
+  uint32_t min_gap_ms;     // shortest time between two sends
+  uint32_t last_send_ms;
+  bool is_sent_busy;       // a frame was sent while the queue was busy
+  bool is_sent_twice;      // the same frame was sent twice
+};
+
+static void Poll(ClientPushPolicy &policy, SimClient &client, uint32_t now, uint32_t frame) {
+  ClientPushSlot *slot = policy.find(client.id);
+  bool is_busy = (int32_t)(client.busy_until - now) > 0;
+
+  if (!slot || !policy.poll(*slot, now, is_busy)) {
+    return;
+  }
+
+  if (is_busy) {
+    client.is_sent_busy = true;
+  }
+  if (frame == client.last_frame) {
+    client.is_sent_twice = true;
+  }
+  if (slot->sentFrames > 1 && now - client.last_send_ms < client.min_gap_ms) {
+    client.min_gap_ms = now - client.last_send_ms;
+  }
+  client.last_frame = frame;
+  client.last_send_ms = now;
+  client.busy_until = now + client.stall_ms;
+}
+
+// 40 Hz producer, two clients polled every ms
+static void Test_two_clients(uint32_t start_ms) {
+  ClientPushPolicy policy(PUSH_INTERVAL_MS);
+  SimClient clients[2] = {
+    {1, 0, start_ms, 0, 0xFFFFFFFF, 0, false, false},    // fast
+    {2, 300, start_ms, 0, 0xFFFFFFFF, 0, false, false},  // 300 ms queue stall
+  };
+  policy.add(clients[0].id);
+  policy.add(clients[1].id);
+
+  uint32_t frame = 0;
+  for (uint32_t t = 0; t < RUN_MS; t++) {
+    uint32_t now = start_ms + t;
+    if (t % FRAME_MS == 0) {
+      frame++;
+      policy.framePublished();
+    }
+    for (SimClient &client : clients) {
+      Poll(policy, client, now, frame);
+    }
+  }
+
+  const ClientPushSlot &fast = *policy.find(1);
+  const ClientPushSlot &slow = *policy.find(2);
+  printf("start %10u ms, %u frames: fast client %u sent / %u dropped, slow client %u sent / %u dropped\n",
+         start_ms, frame, fast.sentFrames, fast.droppedFrames, slow.sentFrames, slow.droppedFrames);
+
+  Check(fast.sentFrames + fast.droppedFrames + fast.pending == frame, "fast client: every frame sent or dropped");
+  Check(slow.sentFrames + slow.droppedFrames + slow.pending == frame, "slow client: every frame sent or dropped");
+  Check(fast.sentFrames == RUN_MS / PUSH_INTERVAL_MS, "fast client: limited to 20 frames/s");
+  Check(clients[0].min_gap_ms >= PUSH_INTERVAL_MS, "fast client: at least 50 ms between two frames");
+  Check(slow.sentFrames <= RUN_MS / 300 + 1 && slow.sentFrames >= RUN_MS / 300 - 1,
+        "slow client: one frame per 300 ms queue stall");
+  Check(!clients[1].is_sent_busy, "slow client: nothing sent while the queue is busy");
+  Check(!clients[0].is_sent_twice && !clients[1].is_sent_twice, "no frame sent twice to a client");
+}
+
+static void Test_slots() {
+  ClientPushPolicy policy(PUSH_INTERVAL_MS);
+  bool added = true;
+  for (uint32_t id = 1; id <= PUSH_POLICY_MAX_CLIENTS; id++) {
+    added = policy.add(id) && added;
+  }
+  Check(added && !policy.add(100), "8 clients, the 9th is refused");
+
+  policy.remove(3);
+  Check(!policy.find(3) && policy.add(100) && policy.find(100), "removed client frees its slot");
+
+  // Per client rate
+  policy.setMinInterval(100, 200);
+  ClientPushSlot &slot = *policy.find(100);
+  policy.framePublished();
+  bool first = policy.poll(slot, 1000, false);
+  policy.framePublished();
+  bool early = policy.poll(slot, 1199, false);
+  bool due = policy.poll(slot, 1200, false);
+  Check(first && !early && due, "setMinInterval() 200 ms for one client");
+
+  // Nothing new, nothing sent
+  Check(!policy.poll(slot, 5000, false), "no new frame: nothing sent");
+
+  // A waiting frame replaced by a newer one
+  policy.framePublished();
+  policy.framePublished();
+  Check(slot.droppedFrames == 1 && policy.poll(slot, 6000, false), "newer frame coalesces the waiting one");
+}
+
+static void Bench() {
+  ClientPushPolicy policy(PUSH_INTERVAL_MS);
+  for (uint32_t id = 1; id <= PUSH_POLICY_MAX_CLIENTS; id++) {
+    policy.add(id);
+  }
+
+  const uint32_t n = 10000000;
+  uint32_t sent = 0;
+  double start = Now_ns();
+  for (uint32_t t = 0; t < n; t++) {
+    if (t % FRAME_MS == 0) {
+      policy.framePublished();
+    }
+    for (uint8_t i = 0; i < PUSH_POLICY_MAX_CLIENTS; i++) {
+      sent += policy.poll(policy.slot(i), t, (t + i) & 4);
+    }
+  }
+  printf("loop() poll of %u clients %.1f ns (sent %u)\n", PUSH_POLICY_MAX_CLIENTS, (Now_ns() - start) / n, sent);
+}
+
+int main() {
+  Test_two_clients(0);
+  Test_two_clients(0xFFFFFFFF - RUN_MS / 2);  // millis() wraps after 49.7 days
+  Test_slots();
+  printf("\n");
+
+  Bench();
+  return Check_result();
+}
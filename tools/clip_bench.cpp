@@ -0,0 +1,146 @@
+/*
+File: clip_bench.cpp
+Host check and benchmark of the clip player (include/clip.h) with the
+clips of the firmware: every frame is compared with a plain reference
+decoder, then the decode cost per frame is timed like Clip_benchmark()
+of main.cpp, without show().
+
+  g++ -O2 -std=gnu++17 -Iinclude -Isim tools/clip_bench.cpp src/clip.cpp \
+      sim/sim_arduino.cpp sim/sim_radar.cpp sim/sim_neopixel.cpp -o clip_bench
+  ./clip_bench
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include <Adafruit_NeoPixel.h>
+
+#include "clip.h"
+#include "clip_breathe.h"
+#include "clip_comet.h"
+#include "sim.h"
+#include "bench.h"
+
+#define MAX_LEDS 256
+
+Sim_stats sim_stats;  // used by the shim
+
+// Straight decode of the format in clip.h into rgb, from the frame at p.
+// Returns the next frame.
+static const uint8_t *Reference_frame(const uint8_t *p, uint16_t led_count, uint8_t *rgb) {
+  if (*p++ == CLIP_FRAME_KEY) {
+    memset(rgb, 0, led_count * 3);
+  }
+
+  uint16_t led = 0;
+  while (led < led_count) {
+    uint8_t op = *p++;
+    uint16_t run = (op & 0x3F) + 1;
+
+    for (uint16_t i = 0; i < run; i++, led++) {
+      if ((op & 0xC0) == 0x80) {
+        memcpy(&rgb[led * 3], p, 3);
+      } else if ((op & 0xC0) == 0xC0) {
+        memcpy(&rgb[led * 3], p + i * 3, 3);
+      }
+    }
+    p += (op & 0xC0) == 0x80 ? 3 : (op & 0xC0) == 0xC0 ? run * 3 : 0;
+  }
+  return p;
+}
+
+static void Test_clip(const uint8_t *clip, size_t size, const char *name) {
+  char what[64];
+  ClipPlayer player;
+  bool is_started = player.start(clip, false, 0);
+  uint16_t led_count = player.led_count();
+  Adafruit_NeoPixel strip(led_count, 0, NEO_RGB + NEO_KHZ800);  // wire order is r g b
+
+  uint8_t rgb[MAX_LEDS * 3];
+  const uint8_t *p = clip + CLIP_HEADER_SIZE;
+  uint16_t frames = 0;
+  bool is_same = is_started && led_count <= MAX_LEDS;
+  while (is_same && player.decode_frame(strip)) {
+    p = Reference_frame(p, led_count, rgb);
+    is_same = memcmp(strip.getPixels(), rgb, led_count * 3) == 0;
+    frames++;
+  }
+  snprintf(what, sizeof(what), "%s: %u frames same as the reference decoder", name, frames);
+  Check(is_same && frames == player.frame_count(), what);
+  snprintf(what, sizeof(what), "%s: frames end at the end of the clip", name);
+  Check(p == clip + size, what);
+
+  // Looping starts again at frame 0, a keyframe
+  uint8_t first[MAX_LEDS * 3];
+  player.start(clip, true, 0);
+  player.decode_frame(strip);
+  memcpy(first, strip.getPixels(), led_count * 3);
+  for (uint16_t i = 0; i < player.frame_count(); i++) {
+    player.decode_frame(strip);
+  }
+  snprintf(what, sizeof(what), "%s: loop starts again at frame 0", name);
+  Check(player.frame_index() == 1 && memcmp(strip.getPixels(), first, led_count * 3) == 0, what);
+}
+
+static void Test_player() {
+  ClipPlayer player;
+  Adafruit_NeoPixel strip(59, 0, NEO_RGB + NEO_KHZ800);
+
+  uint8_t bad[sizeof(CLIP_COMET)];
+  memcpy(bad, CLIP_COMET, sizeof(bad));
+  bad[2] = CLIP_VERSION + 1;
+  Check(!player.start(bad, false, 0) && !player.is_playing(), "unknown version refused");
+
+  memcpy(bad, CLIP_COMET, sizeof(bad));
+  bad[CLIP_HEADER_SIZE] = 2;
+  Check(player.start(bad, false, 0) && !player.decode_frame(strip), "broken frame type stops decoding");
+
+  // CLIP_COMET has 30 ms frames
+  player.start(CLIP_COMET, false, 1000);
+  bool early = player.update(strip, 999);
+  bool first = player.update(strip, 1000);
+  uint16_t after_first = player.frame_index();
+  player.update(strip, 1000 + 5 * 30);
+  Check(!early && first && after_first == 1 && player.frame_index() == 6, "update() decodes the frames due");
+
+  // A long stall catches up at most 8 frames, then restarts the timing
+  player.update(strip, 1000 + 40 * 30);
+  uint16_t after_stall = player.frame_index();
+  bool next = player.update(strip, 1000 + 40 * 30 + 30);
+  Check(after_stall == 6 + 9 && next && player.frame_index() == after_stall + 1, "late update() catches up 8 frames");
+
+  // Not looping: stops after the last frame
+  player.start(CLIP_COMET, false, 0);
+  for (uint32_t now_ms = 0; now_ms <= 60 * 30; now_ms += 30) {
+    player.update(strip, now_ms);
+  }
+  Check(!player.is_playing(), "clip without loop stops at its end");
+}
+
+static void Bench(const uint8_t *clip, size_t size, const char *name) {
+  ClipPlayer player;
+  player.start(clip, true, 0);
+  Adafruit_NeoPixel strip(player.led_count(), 0, NEO_GRB + NEO_KHZ800);
+  strip.setBrightness(75);  // BRIGHTNESS of main.cpp
+
+  const uint32_t n = 1000000;
+  uint32_t frames = 0;
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    frames += player.decode_frame(strip);
+  }
+  double ns = (Now_ns() - start) / n;
+
+  printf("%-8s %u LEDs, %4u bytes: decode %6.1f ns per frame, %4.2f ns per LED (frames %u)\n", name,
+         player.led_count(), (unsigned)size, ns, ns / player.led_count(), frames);
+}
+
+int main() {
+  Test_clip(CLIP_COMET, sizeof(CLIP_COMET), "comet");
+  Test_clip(CLIP_BREATHE, sizeof(CLIP_BREATHE), "breathe");
+  Test_player();
+  printf("\n");
+
+  Bench(CLIP_COMET, sizeof(CLIP_COMET), "comet");
+  Bench(CLIP_BREATHE, sizeof(CLIP_BREATHE), "breathe");
+  return Check_result();
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Write the demo animations as PPM for tools/clip_encode.py.
+
+  comet    a comet with a fading tail runs around the strip
+  breathe  the whole strip breathes in warm white
+
+Usage:
+  tools/clip_demo.py comet comet.ppm --leds 59
+"""
+
+import argparse
+import math
+import sys
+
+
+def comet(leds):
+    tail = 8
+    frames = []
+    for head in range(leds):
+        frame = [(0, 0, 0)] * leds
+        for t in range(tail):
+            level = 255 >> t
+            frame[(head - t) % leds] = (level // 4, level // 2, level)
+        frames.append(frame)
+    return frames
+
+
+def breathe(leds):
+    frames = []
+    steps = 100
+    for i in range(steps):
+        level = int(round(8 + 200 * (1 - math.cos(2 * math.pi * i / steps)) / 2))
+        frames.append([(level, level * 3 // 4, level // 3)] * leds)
+    return frames
+
+
+DEMOS = {'comet': comet, 'breathe': breathe}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Write a demo animation as PPM.')
+    parser.add_argument('demo', choices=sorted(DEMOS))
+    parser.add_argument('output', help='PPM to write')
+    parser.add_argument('--leds', type=int, default=59, help='number of LEDs, default 59')
+    args = parser.parse_args()
+
+    frames = DEMOS[args.demo](args.leds)
+    with open(args.output, 'wb') as f:
+        f.write(b'P6\n%d %d\n255\n' % (args.leds, len(frames)))
+        for frame in frames:
+            for color in frame:
+                f.write(bytes(color))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
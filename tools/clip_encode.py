@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Encode an LED animation into a compressed clip header for the firmware.
+
+Input is a binary PPM (P6) with one row per frame and one column per LED,
+for example the --ppm output of the simulation or an image made in any
+image editor. Output is a C header with the clip as a const byte array,
+which the RP2040 keeps in flash.
+
+Clip format (little-endian), see include/clip.h:
+  header  'L' 'C' version(1) reserved(0)
+          uint16 led_count, uint16 frame_count, uint16 frame_ms
+  frames  type byte: 0 = keyframe (starts from black), 1 = delta (starts
+          from the previous frame), followed by ops until led_count LEDs
+          are covered:
+            00nnnnnn              skip n+1 LEDs (unchanged)
+            10nnnnnn r g b        n+1 LEDs of one color
+            11nnnnnn (r g b)*     n+1 LEDs of their own colors
+
+Usage:
+  tools/clip_encode.py comet.ppm include/clip_comet.h --name comet --frame-ms 30
+"""
+
+import argparse
+import sys
+
+FORMAT_VERSION = 1
+FRAME_KEY = 0
+FRAME_DELTA = 1
+OP_SKIP = 0x00
+OP_REPEAT = 0x80
+OP_LITERAL = 0xC0
+OP_MAX_RUN = 64
+
+
+def read_ppm(path):
+    """Returns (width, height, rows), rows is a list of lists of (r, g, b)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    # Header: magic, width, height, maxval, comments start with #
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos) + 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    pos += 1
+
+    if fields[0] != b'P6' or int(fields[3]) != 255:
+        raise ValueError('%s: only 8 bit binary PPM (P6) is supported' % path)
+
+    width, height = int(fields[1]), int(fields[2])
+    pixels = data[pos:pos + width * height * 3]
+    if len(pixels) < width * height * 3:
+        raise ValueError('%s: truncated' % path)
+
+    rows = []
+    for y in range(height):
+        row = pixels[y * width * 3:(y + 1) * width * 3]
+        rows.append([tuple(row[i:i + 3]) for i in range(0, len(row), 3)])
+    return width, height, rows
+
+
+def encode_ops(frame, previous):
+    """Ops that turn previous into frame."""
+    out = bytearray()
+    count = len(frame)
+    i = 0
+    while i < count:
+        # Unchanged LEDs
+        run = 0
+        while i + run < count and run < OP_MAX_RUN and frame[i + run] == previous[i + run]:
+            run += 1
+        if run:
+            out.append(OP_SKIP | (run - 1))
+            i += run
+            continue
+
+        # LEDs of one color
+        run = 1
+        while i + run < count and run < OP_MAX_RUN and frame[i + run] == frame[i]:
+            run += 1
+        if run >= 2:
+            out.append(OP_REPEAT | (run - 1))
+            out.extend(frame[i])
+            i += run
+            continue
+
+        # Changed LEDs until an unchanged LED or a repeat
+        run = 1
+        while (i + run < count and run < OP_MAX_RUN and frame[i + run] != previous[i + run]
+               and not (i + run + 1 < count and frame[i + run + 1] == frame[i + run])):
+            run += 1
+        out.append(OP_LITERAL | (run - 1))
+        for color in frame[i:i + run]:
+            out.extend(color)
+        i += run
+    return out
+
+
+def encode_clip(rows, frame_ms, keyframe_interval):
+    count = len(rows[0])
+    black = [(0, 0, 0)] * count
+
+    out = bytearray(b'LC')
+    out += bytes([FORMAT_VERSION, 0])
+    out += count.to_bytes(2, 'little')
+    out += len(rows).to_bytes(2, 'little')
+    out += frame_ms.to_bytes(2, 'little')
+
+    keyframes = 0
+    previous = black
+    for index, frame in enumerate(rows):
+        key = encode_ops(frame, black)
+        delta = encode_ops(frame, previous)
+
+        # Frame 0 must be a keyframe, playback loops back to it
+        if index == 0 or index % keyframe_interval == 0 or len(key) <= len(delta):
+            out.append(FRAME_KEY)
+            out += key
+            keyframes += 1
+        else:
+            out.append(FRAME_DELTA)
+            out += delta
+        previous = frame
+    return out, keyframes
+
+
+def write_header(path, name, clip, led_count, frame_count, frame_ms, keyframes):
+    symbol = 'CLIP_' + name.upper()
+    guard = symbol + '_H'
+    raw = led_count * frame_count * 3
+
+    lines = [
+        '/*',
+        'File: %s' % path.split('/')[-1],
+        'Generated by tools/clip_encode.py, do not edit.',
+        '',
+        '%u LEDs, %u frames, %u ms per frame, %u keyframes' % (led_count, frame_count, frame_ms, keyframes),
+        '%u bytes, raw %u bytes (%.1f %%)' % (len(clip), raw, 100.0 * len(clip) / raw),
+        '*/',
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+        '#include <stdint.h>',
+        '',
+        'const uint8_t %s[] = {' % symbol,
+    ]
+    for i in range(0, len(clip), 16):
+        lines.append('  ' + ', '.join('0x%02X' % b for b in clip[i:i + 16]) + ',')
+    lines += ['};', '', '#endif  // %s' % guard, '']
+
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Encode a PPM animation into a clip header.')
+    parser.add_argument('input', help='PPM, one row per frame, one column per LED')
+    parser.add_argument('output', help='C header to write')
+    parser.add_argument('--name', required=True, help='clip name, the array is CLIP_<NAME>')
+    parser.add_argument('--frame-ms', type=int, default=40, help='time per frame, default 40')
+    parser.add_argument('--keyframe', type=int, default=50, help='keyframe every n frames, default 50')
+    args = parser.parse_args()
+
+    width, height, rows = read_ppm(args.input)
+    if width > 0xFFFF or height > 0xFFFF or not 0 < args.frame_ms <= 0xFFFF or args.keyframe < 1:
+        parser.error('clip too large or bad option')
+
+    clip, keyframes = encode_clip(rows, args.frame_ms, args.keyframe)
+    write_header(args.output, args.name, clip, width, height, args.frame_ms, keyframes)
+    print('%s: %u LEDs, %u frames, %u bytes (raw %u)' % (args.output, width, height, len(clip), width * height * 3))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,311 @@
+/*
+File: ld2410_ack_bench.cpp
+Host check of the LD2410 command path against a scripted radar with
+injected ACK delays, on the virtual clock of the simulation shim:
+learning of the ACK timeout, time to fail on a dead radar, config mode
+handling and which commands are repeated.
+
+  g++ -O2 -std=gnu++17 -Isim -Ilib/LD2410/src tools/ld2410_ack_bench.cpp \
+      lib/LD2410/src/LD2410.cpp sim/sim_arduino.cpp sim/sim_radar.cpp -o ld2410_ack_bench
+  ./ld2410_ack_bench
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "LD2410.h"
+#include "sim.h"
+#include "bench.h"
+
+#define FRAME_US       100000  // LD2410 data frame interval
+#define FRAME_PHASE_US 37000
+#define CALL_GAP_US    200000  // between two commands of a test
+
+Sim_stats sim_stats;  // used by the shim
+
+// LD2410 on the virtual clock: answers every command after ack_delay_us
+// and sends a data frame every 100 ms outside the config mode
+class AckRadar : public Stream {
+ public:
+  uint32_t ack_delay_us = 2000;
+  bool is_dead = false;            // sends and answers nothing
+  bool ignores_enable = false;     // never answers ENABLE_CONFIG_MODE
+  uint16_t drop_command = 0;       // never answers this command
+  uint32_t frames_written = 0;
+
+  int available() override {
+    _receive();
+    return (int)_rx.size();
+  }
+
+  int read() override {
+    _receive();
+    if (_rx.empty()) {
+      return -1;
+    }
+    int c = _rx.front();
+    _rx.pop_front();
+    return c;
+  }
+
+  // LD2410 writes every command frame at once
+  size_t write(uint8_t c) override {
+    (void)c;
+    return 1;
+  }
+
+  size_t write(const uint8_t *frame, size_t size) override {
+    frames_written++;
+    if (size >= 8) {
+      _command(frame[6] << 8 | frame[7]);
+    }
+    return size;
+  }
+  using Print::write;
+
+  uint32_t written(uint16_t cmd) { return _written[cmd]; }
+
+ private:
+  struct Pending {
+    uint64_t due_us;
+    std::vector<uint8_t> bytes;
+  };
+
+  std::vector<Pending> _pending;
+  std::deque<uint8_t> _rx;
+  std::map<uint16_t, uint32_t> _written;
+  bool _is_config_mode = false;
+  uint64_t _next_data_us = FRAME_PHASE_US;
+
+  static void _frame(std::vector<uint8_t> &bytes, bool is_data, const uint8_t *data, uint8_t length) {
+    static const uint8_t command_header[4] = {0xFD, 0xFC, 0xFB, 0xFA};
+    static const uint8_t command_tail[4] = {0x04, 0x03, 0x02, 0x01};
+    static const uint8_t data_header[4] = {0xF4, 0xF3, 0xF2, 0xF1};
+    static const uint8_t data_tail[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+
+    bytes.insert(bytes.end(), is_data ? data_header : command_header, (is_data ? data_header : command_header) + 4);
+    bytes.push_back(length);
+    bytes.push_back(0);
+    bytes.insert(bytes.end(), data, data + length);
+    bytes.insert(bytes.end(), is_data ? data_tail : command_tail, (is_data ? data_tail : command_tail) + 4);
+  }
+
+  void _command(uint16_t cmd) {
+    _written[cmd]++;
+    if (is_dead || (ignores_enable && cmd == LD2410::ENABLE_CONFIG_MODE) || cmd == drop_command) {
+      return;
+    }
+
+    if (cmd == LD2410::ENABLE_CONFIG_MODE) {
+      _is_config_mode = true;
+    } else if (cmd == LD2410::DISABLE_CONFIG_MODE || cmd == LD2410::RESTART) {
+      _is_config_mode = false;
+    }
+
+    uint8_t ack[32] = {(uint8_t)(cmd >> 8), (uint8_t)(cmd | 0x01), 0x00, 0x00};
+    uint8_t length = 4;
+    if (cmd == LD2410::ENABLE_CONFIG_MODE) {
+      // protocol version 1, buffer size 64
+      const uint8_t payload[] = {0x01, 0x00, 0x40, 0x00};
+      memcpy(&ack[length], payload, sizeof(payload));
+      length += sizeof(payload);
+    } else if (cmd == LD2410::READ_PARAMETER) {
+      ack[length++] = 0xAA;
+      memset(&ack[length], 8, 3);
+      memset(&ack[length + 3], 40, 18);
+      ack[length + 21] = 5;  // detection time
+      ack[length + 22] = 0;
+      length += 23;
+    }
+
+    Pending pending;
+    pending.due_us = sim_now_us() + ack_delay_us;
+    _frame(pending.bytes, false, ack, length);
+    _pending.push_back(pending);
+  }
+
+  // Frames sent until now
+  void _receive() {
+    uint64_t now = sim_now_us();
+
+    for (; _next_data_us <= now; _next_data_us += FRAME_US) {
+      if (!is_dead && !_is_config_mode) {
+        const uint8_t data[13] = {0x02, 0xAA, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0x55, 0x00};
+        Pending pending;
+        pending.due_us = _next_data_us;
+        _frame(pending.bytes, true, data, sizeof(data));
+        _pending.push_back(pending);
+      }
+    }
+
+    std::stable_sort(_pending.begin(), _pending.end(),
+                     [](const Pending &a, const Pending &b) { return a.due_us < b.due_us; });
+    while (!_pending.empty() && _pending.front().due_us <= now) {
+      _rx.insert(_rx.end(), _pending.front().bytes.begin(), _pending.front().bytes.end());
+      _pending.erase(_pending.begin());
+    }
+  }
+};
+
+// Time and frames of one command
+struct Call {
+  bool ok;
+  double ms;
+  uint32_t frames;
+};
+
+template <typename F>
+static Call Run(AckRadar &stream, LD2410 &radar, F command) {
+  // the firmware keeps reading the radar between the commands
+  for (uint32_t us = 0; us < CALL_GAP_US; us += 1000) {
+    sim_advance_us(1000);
+    while (stream.available()) {
+      radar.read();
+    }
+  }
+
+  uint32_t frames = stream.frames_written;
+  uint64_t start_us = sim_now_us();
+  bool ok = command();
+  return {ok, (sim_now_us() - start_us) / 1000.0, stream.frames_written - frames};
+}
+
+// Learn the ACK timeout over 50 reads, then the radar dies
+static void Test_ack_delay(uint32_t ack_delay_ms, uint32_t max_failures, double max_dead_ms) {
+  AckRadar stream;
+  LD2410 radar(stream);
+  stream.ack_delay_us = ack_delay_ms * 1000;
+
+  uint32_t failures = 0, late_failures = 0;
+  for (uint32_t i = 0; i < 50; i++) {
+    Call call = Run(stream, radar, [&] { return radar.readParameter(); });
+    failures += !call.ok;
+    late_failures += !call.ok && i >= 10;
+  }
+  uint32_t retries = radar.rttStatistics(LD2410::READ_PARAMETER).retries;
+
+  stream.is_dead = true;
+  Call dead = Run(stream, radar, [&] { return radar.readParameter(); });
+
+  printf("ACK delay %3u ms: %2u/50 failed, %u retries, dead radar fails after %5.1f ms, %u frame\n",
+         ack_delay_ms, failures, retries, dead.ms, dead.frames);
+
+  char what[80];
+  snprintf(what, sizeof(what), "ACK delay %u ms: at most %u failures while learning", ack_delay_ms, max_failures);
+  Check(failures <= max_failures && late_failures == 0, what);
+  snprintf(what, sizeof(what), "ACK delay %u ms: dead radar fails within %.0f ms", ack_delay_ms, max_dead_ms);
+  Check(!dead.ok && dead.ms <= max_dead_ms && dead.frames == 1, what);
+}
+
+// No radar at all: only the enable is sent
+static void Test_dead_radar() {
+  AckRadar stream;
+  LD2410 radar(stream);
+  stream.is_dead = true;
+
+  const uint8_t moving[9] = {50, 50, 40, 30, 20, 15, 15, 15, 15};
+  const uint8_t stationary[9] = {0, 0, 40, 40, 30, 30, 20, 20, 20};
+
+  Call set = Run(stream, radar, [&] { return radar.setMaxDistAndDur(6, 6, 5); });
+  Call read = Run(stream, radar, [&] { return radar.readParameter(); });
+  Call batch = Run(stream, radar, [&] { return radar.setGateSensConf(moving, stationary); });
+
+  printf("dead radar: setMaxDistAndDur %5.1f ms %u frame, readParameter %5.1f ms %u frame, "
+         "9 gates %5.1f ms %u frame\n", set.ms, set.frames, read.ms, read.frames, batch.ms, batch.frames);
+
+  Check(!set.ok && set.ms <= 101 && set.frames == 1, "dead radar: setMaxDistAndDur() 100 ms, 1 frame");
+  Check(!read.ok && read.ms <= 101 && read.frames == 1, "dead radar: readParameter() 100 ms, 1 frame");
+  Check(!batch.ok && batch.ms <= 101 && batch.frames == 1, "dead radar: 9 gate batch 100 ms, 1 frame");
+}
+
+// Radar sends data but doesn't enter the config mode: one disable, no command
+static void Test_ignored_enable() {
+  AckRadar stream;
+  LD2410 radar(stream);
+  stream.ignores_enable = true;
+
+  Call set = Run(stream, radar, [&] { return radar.setMaxDistAndDur(6, 6, 5); });
+
+  printf("enable ignored: setMaxDistAndDur %5.1f ms, %u frames\n", set.ms, set.frames);
+  Check(!set.ok && stream.written(LD2410::SET_MAX_DIST_AND_DUR) == 0, "enable ignored: the command is not sent");
+  Check(stream.written(LD2410::ENABLE_CONFIG_MODE) == 1 && stream.written(LD2410::DISABLE_CONFIG_MODE) == 1,
+        "enable ignored: one enable, one disable");
+}
+
+// Lost ACKs: reads and sets are repeated, actions are not
+static void Test_repeat() {
+  const struct {
+    LD2410::RadarCommand cmd;
+    const char *what;
+    uint32_t frames;
+  } cases[] = {
+    {LD2410::READ_PARAMETER, "lost ACK, 2 retries: readParameter() sent 3 times", 3},
+    {LD2410::SET_MAX_DIST_AND_DUR, "lost ACK, 2 retries: setMaxDistAndDur() sent 3 times", 3},
+    {LD2410::RESTART, "lost ACK, 2 retries: restart() sent once", 1},
+    {LD2410::FACTORY_RESET, "lost ACK, 2 retries: factoryReset() sent once", 1},
+    {LD2410::SET_BAUDRATE, "lost ACK, 2 retries: setBaudRate() sent once", 1},
+  };
+
+  for (const auto &c : cases) {
+    AckRadar stream;
+    LD2410 radar(stream);
+    radar.setRetries(2);
+    stream.drop_command = c.cmd;
+
+    Run(stream, radar, [&] {
+      switch (c.cmd) {
+        case LD2410::READ_PARAMETER:
+          return radar.readParameter();
+        case LD2410::SET_MAX_DIST_AND_DUR:
+          return radar.setMaxDistAndDur(6, 6, 5);
+        case LD2410::RESTART:
+          return radar.restart();
+        case LD2410::FACTORY_RESET:
+          return radar.factoryReset();
+        default:
+          return radar.setBaudRate(BAUD_256000);
+      }
+    });
+    Check(stream.written(c.cmd) == c.frames, c.what);
+  }
+}
+
+// 9 gates in one pipelined session vs 9 single commands
+static void Bench_batch() {
+  const uint8_t moving[9] = {50, 50, 40, 30, 20, 15, 15, 15, 15};
+  const uint8_t stationary[9] = {0, 0, 40, 40, 30, 30, 20, 20, 20};
+
+  AckRadar stream;
+  LD2410 radar(stream);
+
+  Call batch = Run(stream, radar, [&] { return radar.setGateSensConf(moving, stationary); });
+  Call single = Run(stream, radar, [&] {
+    bool ok = true;
+    for (uint8_t gate = 0; gate <= 8; gate++) {
+      ok = radar.setGateSensConf(gate, moving[gate], stationary[gate]) && ok;
+    }
+    return ok;
+  });
+
+  printf("9 gates, ACK delay 2 ms: batch %5.1f ms %2u frames, single commands %5.1f ms %2u frames\n",
+         batch.ms, batch.frames, single.ms, single.frames);
+  Check(batch.ok && single.ok && batch.ms < single.ms, "9 gates: batch faster than single commands");
+}
+
+int main() {
+  Test_ack_delay(2, 0, 15);
+  Test_ack_delay(30, 0, 70);
+  // over the 100 ms default: 4 late ACKs each teach the enable and the disable
+  Test_ack_delay(150, 8, 320);
+  Test_dead_radar();
+  Test_ignored_enable();
+  Test_repeat();
+  printf("\n");
+
+  Bench_batch();
+  return Check_result();
+}
@@ -0,0 +1,79 @@
+/*
+File: ld2410_command_bench.cpp
+Host benchmark of the LD2410 command encoder (lib/LD2410/src/LD2410Command.h).
+Checks the encoded frames against frames captured from the radar
+protocol first, then times the encoding.
+
+  g++ -O2 -std=gnu++17 -Ilib/LD2410/src tools/ld2410_command_bench.cpp -o ld2410_command_bench
+  ./ld2410_command_bench
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include "LD2410Command.h"
+#include "bench.h"
+
+static bool Same_frame(const uint8_t *frame, size_t size, const uint8_t *expected, size_t expected_size) {
+  return size == expected_size && !memcmp(frame, expected, size);
+}
+
+int main() {
+  // enable config mode
+  const uint8_t enable_config[] = {0xFD, 0xFC, 0xFB, 0xFA, 0x04, 0x00, 0xFF, 0x00, 0x01, 0x00,
+                                   0x04, 0x03, 0x02, 0x01};
+  // read parameter
+  const uint8_t read_parameter[] = {0xFD, 0xFC, 0xFB, 0xFA, 0x02, 0x00, 0x61, 0x00, 0x04, 0x03, 0x02, 0x01};
+  // set gate 3 sensitivity to 45 % moving and 67 % stationary
+  const uint8_t gate_sens[] = {0xFD, 0xFC, 0xFB, 0xFA, 0x14, 0x00, 0x64, 0x00, 0x00, 0x00, 0x03, 0x00,
+                               0x00, 0x00, 0x01, 0x00, 0x2D, 0x00, 0x00, 0x00, 0x02, 0x00, 0x43, 0x00,
+                               0x00, 0x00, 0x04, 0x03, 0x02, 0x01};
+  // set max moving gate 6, max stationary gate 5, duration 300 s
+  const uint8_t max_dist[] = {0xFD, 0xFC, 0xFB, 0xFA, 0x14, 0x00, 0x60, 0x00, 0x00, 0x00, 0x06, 0x00,
+                              0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x00, 0x00, 0x02, 0x00, 0x2C, 0x01,
+                              0x00, 0x00, 0x04, 0x03, 0x02, 0x01};
+
+  LD2410ValueCommand enable(0xFF00);
+  enable.add16(0x0001);
+  LD2410EmptyCommand read(0x6100);
+  LD2410ParameterCommand gate(0x6400);
+  gate.addParameter(0, 3).addParameter(1, 45).addParameter(2, 67);
+  LD2410ParameterCommand dist(0x6000);
+  dist.addParameter(0, 6).addParameter(1, 5).addParameter(2, 300);
+
+  Check(Same_frame(enable.data(), enable.size(), enable_config, sizeof(enable_config)), "enable config frame");
+  Check(Same_frame(read.data(), read.size(), read_parameter, sizeof(read_parameter)), "read parameter frame");
+  Check(Same_frame(gate.data(), gate.size(), gate_sens, sizeof(gate_sens)), "gate sensitivity frame");
+  Check(Same_frame(dist.data(), dist.size(), max_dist, sizeof(max_dist)), "max distance frame");
+  if (Check_result()) {
+    return Check_result();
+  }
+  printf("\n");
+
+  const uint32_t n = 10000000;
+  volatile uint8_t sink = 0;
+
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    LD2410EmptyCommand frame(0x6100 + (i & 1));
+    sink += frame.data()[7];
+  }
+  printf("empty command     %2u bytes: %5.1f ns\n", (unsigned)LD2410EmptyCommand::SIZE, (Now_ns() - start) / n);
+
+  start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    LD2410ValueCommand frame(0xFF00);
+    frame.add16(i);
+    sink += frame.data()[8];
+  }
+  printf("value command     %2u bytes: %5.1f ns\n", (unsigned)LD2410ValueCommand::SIZE, (Now_ns() - start) / n);
+
+  start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    LD2410ParameterCommand frame(0x6400);
+    frame.addParameter(0, i % 9).addParameter(1, i & 0x7F).addParameter(2, 100 - (i & 0x3F));
+    sink += frame.data()[10] + frame.data()[16] + frame.data()[22];
+  }
+  printf("parameter command %2u bytes: %5.1f ns\n", (unsigned)LD2410ParameterCommand::SIZE, (Now_ns() - start) / n);
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/*
+File: ld2410_parse_bench.cpp
+Host benchmark of the LD2410 frame parser per compile time policy
+(lib/LD2410/src/LD2410Config.h): cost of read() per normal and per
+engineering mode frame, checked against the encoded values. The stream
+is a plain byte buffer, so the time is the parser's and not a mock's.
+
+Build once per policy, tools/run_benches.sh builds all four:
+
+  g++ -O2 -std=gnu++17 -Isim -Ilib/LD2410/src [-D LD2410_ENGINEERING_MODE=0 ...] \
+      tools/ld2410_parse_bench.cpp lib/LD2410/src/LD2410.cpp \
+      sim/sim_arduino.cpp sim/sim_radar.cpp -o ld2410_parse_bench
+  ./ld2410_parse_bench
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include "LD2410.h"
+#include "sim.h"
+#include "bench.h"
+
+#define FRAMES 1024  // in the buffer, replayed
+
+Sim_stats sim_stats;  // used by the shim
+
+// Radar UART over a buffer of encoded frames, replayed from the start
+class BufferStream : public Stream {
+ public:
+  uint8_t data[FRAMES * 45];
+  size_t size = 0;
+  size_t pos = 0;
+
+  int available() override {
+    if (pos == size) {
+      pos = 0;
+    }
+    return (int)(size - pos);
+  }
+
+  int read() override { return pos < size ? data[pos++] : -1; }
+
+  size_t write(uint8_t c) override {
+    (void)c;
+    return 1;
+  }
+  using Print::write;
+
+  void frame(bool is_engineering, uint8_t state, uint16_t moving_cm, uint8_t energy, uint8_t gate_energy) {
+    static const uint8_t header[4] = {0xF4, 0xF3, 0xF2, 0xF1};
+    static const uint8_t tail[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+
+    uint8_t payload[35] = {(uint8_t)(is_engineering ? 0x01 : 0x02), 0xAA, state,
+                           (uint8_t)moving_cm, (uint8_t)(moving_cm >> 8), energy,
+                           0x2C, 0x01, energy,  // stationary 300 cm
+                           (uint8_t)moving_cm, (uint8_t)(moving_cm >> 8)};
+    uint8_t length = 13;
+    if (is_engineering) {
+      payload[11] = 8;
+      payload[12] = 8;
+      memset(&payload[13], gate_energy, 18);
+      payload[31] = energy;
+      payload[32] = energy;
+      length = 35;
+    }
+    payload[length - 2] = 0x55;
+    payload[length - 1] = 0x00;
+
+    memcpy(&data[size], header, 4);
+    data[size + 4] = length;
+    data[size + 5] = 0;
+    memcpy(&data[size + 6], payload, length);
+    memcpy(&data[size + 6 + length], tail, 4);
+    size += 10 + length;
+  }
+};
+
+static BufferStream stream;
+
+static void Fill(bool is_engineering) {
+  stream.size = 0;
+  stream.pos = 0;
+  for (uint32_t i = 0; i < FRAMES; i++) {
+    stream.frame(is_engineering, i % 4, 50 + i % 500, i % 101, i % 100);
+  }
+}
+
+static void Test(bool is_engineering) {
+  LD2410 radar(stream);
+  Fill(is_engineering);
+
+  bool ok = true;
+  for (uint32_t i = 0; i < FRAMES; i++) {
+    ok = radar.read() && ok;
+    ok = ok && radar.cyclicData.targetState == i % 4 && radar.cyclicData.movingTargetDistance == 50 + i % 500 &&
+         radar.cyclicData.movingTargetEnergy == i % 101 && radar.cyclicData.stationaryTargetDistance == 300 &&
+         radar.cyclicData.radarInEngineeringMode == is_engineering;
+#if LD2410_ENGINEERING_MODE
+    if (is_engineering) {
+      ok = ok && radar.engineeringData.movingEnergyGateN[8] == i % 100 &&
+           radar.engineeringData.stationaryEnergyGateN[0] == i % 100 &&
+           radar.engineeringData.maxMovingEnergy == i % 101;
+    }
+#endif
+  }
+  Check(ok, is_engineering ? "engineering frames parsed" : "normal frames parsed");
+}
+
+static void Bench(bool is_engineering) {
+  LD2410 radar(stream);
+  Fill(is_engineering);
+
+  const uint32_t n = 2000000;
+  uint32_t frames = 0;
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    frames += radar.read();
+  }
+  double ns = (Now_ns() - start) / n;
+
+  printf("%-18s read() %5.1f ns per frame, %4.1f ns per byte (frames %u)\n",
+         is_engineering ? "engineering frame" : "normal frame", ns, ns / (is_engineering ? 45 : 23), frames);
+}
+
+int main() {
+  printf("LD2410_ENGINEERING_MODE %d, LD2410_CONFIG_COMMANDS %d, LD2410_READ_COMMANDS %d: sizeof(LD2410) %u bytes\n",
+         LD2410_ENGINEERING_MODE, LD2410_CONFIG_COMMANDS, LD2410_READ_COMMANDS, (unsigned)sizeof(LD2410));
+  Test(false);
+  Test(true);
+  Bench(false);
+  Bench(true);
+  return Check_result();
+}
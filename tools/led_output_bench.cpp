@@ -0,0 +1,119 @@
+/*
+File: led_output_bench.cpp
+Host check and benchmark of the double buffered LED output
+(src/led_output.cpp) against a mock backend with a virtual clock:
+the encoding, the buffer swap, and the CPU time of submit() compared
+with a blocking show() which holds the CPU for the whole frame.
+
+  g++ -O2 -std=gnu++17 -Iinclude tools/led_output_bench.cpp src/led_output.cpp -o led_output_bench
+  ./led_output_bench
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "led_output.h"
+#include "bench.h"
+
+#define RENDER_US 20000  // 50 fps
+
+// Records the transfers instead of starting DMA
+class MockOutput : public Ws2812Output {
+ public:
+  uint32_t now_us = 0;
+  uint32_t transfers = 0;
+  uint32_t last_words[LED_OUTPUT_MAX_LEDS];
+  uint16_t last_count = 0;
+  const uint32_t *last_buffer = NULL;
+
+ protected:
+  void _transmit(const uint32_t *words, uint16_t count) override {
+    memcpy(last_words, words, count * sizeof(uint32_t));
+    last_count = count;
+    last_buffer = words;
+    transfers++;
+  }
+
+  uint32_t _now_us() override { return now_us; }
+};
+
+static void Test_encode() {
+  const uint8_t grb[6] = {0x12, 0x34, 0x56, 0xFF, 0x00, 0x80};
+  uint32_t words[2];
+  Ws2812_encode(grb, 2, words);
+  Check(words[0] == 0x12345600 && words[1] == 0xFF008000, "encode G R B into bits 31..8");
+}
+
+static void Test_swap() {
+  MockOutput out;
+  uint8_t frame_a[3 * 4], frame_b[3 * 4], frame_c[3 * 4];
+  memset(frame_a, 0x11, sizeof(frame_a));
+  memset(frame_b, 0x22, sizeof(frame_b));
+  memset(frame_c, 0x33, sizeof(frame_c));
+  uint32_t wire_us = 4 * WS2812_LED_US + WS2812_RESET_US;
+
+  out.submit(frame_a, 4);
+  Check(out.transfers == 1 && out.last_words[0] == 0x11111100, "idle wire: submit sends at once");
+  const uint32_t *front = out.last_buffer;
+
+  // The caller may draw the next frame right away
+  memset(frame_a, 0, sizeof(frame_a));
+  out.now_us += 10;
+  out.submit(frame_b, 4);
+  Check(out.transfers == 1 && out.busy(), "busy wire: submit waits");
+
+  out.submit(frame_c, 4);
+  Check(out.stats().dropped == 1, "newer frame replaces the waiting one");
+
+  out.service();
+  Check(out.transfers == 1, "service keeps waiting while on the wire");
+
+  out.now_us = wire_us;
+  out.service();
+  Check(out.transfers == 2 && out.last_words[0] == 0x33333300, "service sends the latest frame");
+  Check(out.last_buffer != front, "buffers swapped");
+
+  out.now_us += wire_us;
+  out.service();
+  Check(!out.busy() && out.stats().frames == 2 && out.stats().submits == 3, "idle after the last frame");
+
+  uint8_t big[3 * (LED_OUTPUT_MAX_LEDS + 10)] = {0};
+  out.submit(big, LED_OUTPUT_MAX_LEDS + 10);
+  Check(out.last_count == LED_OUTPUT_MAX_LEDS, "frame clipped to LED_OUTPUT_MAX_LEDS");
+}
+
+static void Bench(uint16_t num_leds) {
+  MockOutput out;
+  static uint8_t grb[LED_OUTPUT_MAX_LEDS * 3];
+
+  const uint32_t n = 200000;
+  double submit_ns = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    grb[(i % num_leds) * 3] = (uint8_t)i;
+
+    double start = Now_ns();
+    out.submit(grb, num_leds);
+    submit_ns += Now_ns() - start;
+
+    out.now_us += RENDER_US;
+  }
+
+  // Blocking show(): the CPU sends every bit of the frame
+  uint32_t show_us = num_leds * WS2812_LED_US + WS2812_RESET_US;
+
+  printf("%3u LEDs: submit %5.0f ns, blocking show %4u us, %4.1f %% of a 50 fps frame recovered (frames %u)\n",
+         num_leds, submit_ns / n, show_us, 100.0 * (show_us - submit_ns / n / 1000) / RENDER_US,
+         out.stats().frames);
+}
+
+int main() {
+  Test_encode();
+  Test_swap();
+  printf("\n");
+
+  Bench(49);   // ring
+  Bench(59);   // square
+  Bench(LED_OUTPUT_MAX_LEDS);
+  return Check_result();
+}
@@ -0,0 +1,55 @@
+/*
+File: light_mapping_bench.cpp
+Host benchmark of the light mapping pass (src/light_mapping.cpp):
+update() and map() of one render frame, for the ring, the square and
+the largest strip.
+
+  g++ -O2 -std=gnu++17 -Iinclude tools/light_mapping_bench.cpp src/light_mapping.cpp -o light_mapping_bench
+  ./light_mapping_bench
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "light_mapping.h"
+#include "bench.h"
+
+#define RENDER_MS 20  // 50 fps
+#define FRAME_MS  100  // LD2410 frame interval
+
+static void Bench(uint16_t num_leds) {
+  LightMapper mapper(num_leds);
+  static uint8_t rgb[LIGHT_MAPPING_MAX_LEDS * 3];
+  uint8_t moving[LIGHT_MAPPING_GATES], stationary[LIGHT_MAPPING_GATES];
+
+  const uint32_t n = 200000;
+  double mapping_ns = 0;
+  uint32_t checksum = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    // New radar frame every FRAME_MS / RENDER_MS render frames, not timed
+    if (i % (FRAME_MS / RENDER_MS) == 0) {
+      for (uint8_t gate = 0; gate < LIGHT_MAPPING_GATES; gate++) {
+        moving[gate] = rand() % 101;
+        stationary[gate] = rand() % 101;
+      }
+      mapper.set_target(rand() % 4, rand() % 600, rand() % 101, rand() % 600, rand() % 101, moving, stationary);
+    }
+
+    double start = Now_ns();
+    mapper.update(RENDER_MS);
+    mapper.map(rgb);
+    mapping_ns += Now_ns() - start;
+
+    checksum += rgb[(i % num_leds) * 3];
+  }
+
+  printf("%3u LEDs: update + map %6.0f ns per frame, %4.1f ns per LED (checksum %u)\n", num_leds,
+         mapping_ns / n, mapping_ns / n / num_leds, checksum);
+}
+
+int main() {
+  Bench(49);   // ring
+  Bench(59);   // square
+  Bench(LIGHT_MAPPING_MAX_LEDS);
+  return 0;
+}
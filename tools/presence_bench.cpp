@@ -0,0 +1,131 @@
+/*
+File: presence_bench.cpp
+Host check of the OUT pin / UART frame arbitration (src/presence.cpp):
+scripted sequences of pin edges and radar frames against the rules in
+include/presence.h, then the cost of the calls.
+
+  g++ -O2 -std=gnu++17 -Iinclude tools/presence_bench.cpp src/presence.cpp -o presence_bench
+  ./presence_bench
+*/
+#include <stdio.h>
+
+#include "presence.h"
+#include "bench.h"
+
+#define PIN_HOLD_MS     1000
+#define UART_TIMEOUT_MS 2000
+
+// Empty room reported every 100 ms until until_ms
+static void Empty_frames(PresenceArbiter &presence, uint32_t from_ms, uint32_t until_ms) {
+  for (uint32_t t = from_ms; t < until_ms; t += 100) {
+    presence.uart_frame(0, t);
+  }
+}
+
+static void Test_fast_path() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  Empty_frames(presence, 0, 1000);
+
+  Check(presence.pin_edge(true, 1050), "rising pin switches the light on at once");
+  Check(presence.present(1060), "present before the UART frame");
+  Check(!presence.pin_edge(true, 1070), "second rising edge: already on");
+}
+
+static void Test_pin_hold() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  Empty_frames(presence, 0, 1000);
+  presence.pin_edge(true, 1000);
+
+  // Frames without a target, older than the detection
+  Check(presence.uart_frame(0, 1100), "pin high, UART empty 100 ms after the edge: pin wins");
+  Check(presence.uart_frame(0, 1900), "pin high, UART empty 900 ms after the edge: pin wins");
+  Check(presence.present(1999), "pin wins until 1 s after the edge");
+  Check(!presence.uart_frame(0, 2000), "pin high, UART empty 1 s after the edge: UART wins");
+  Check(presence.disagreements() == 3, "3 disagreements counted");
+}
+
+static void Test_uart_wins_low_pin() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  presence.pin_edge(true, 0);
+  presence.pin_edge(false, 500);
+
+  Check(presence.uart_frame(2, 600), "pin low, UART stationary target: UART wins");
+  Check(presence.present(2599), "UART target holds while frames are fresh");
+}
+
+static void Test_uart_timeout() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+
+  // No frames at all
+  Check(presence.pin_edge(true, 100), "no UART yet: the pin switches on");
+  presence.pin_edge(false, 500);
+  Check(!presence.present(600), "no UART yet: the pin switches off");
+
+  // Frames stop while a target was reported
+  presence.uart_frame(1, 1000);
+  Check(presence.present(2999), "UART target, 1999 ms old: present");
+  Check(!presence.present(3000), "UART target, 2 s old: stale, pin low decides");
+
+  // Frames stop while the room was empty
+  presence.uart_frame(0, 4000);
+  presence.pin_edge(true, 4500);
+  Check(presence.present(5499), "pin high, UART empty 1.5 s old: pin hold");
+  Check(!presence.present(5500), "pin hold over, UART empty 1.5 s old: UART wins");
+  Check(presence.present(6000), "UART empty 2 s old: stale, pin high decides");
+}
+
+static void Test_stale_edge() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  Empty_frames(presence, 0, 1000);
+
+  // Edge at 1000 ms, handled only after the frame of 1050 ms lit the strip
+  presence.uart_frame(1, 1050);
+  Check(!presence.pin_edge(true, 1000), "edge older than the last frame: no new light");
+  Check(presence.pin_level() && presence.present(1100), "the pin level is still taken");
+
+  // A fresh edge after the frame
+  PresenceArbiter other(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  Empty_frames(other, 0, 1000);
+  Check(other.pin_edge(true, 950), "edge newer than the last frame: light on");
+}
+
+static void Test_wrap() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  uint32_t t = 0xFFFFFF00;  // millis() wraps after 49.7 days
+
+  Empty_frames(presence, t - 1000, t);
+  Check(presence.pin_edge(true, t + 200), "edge across the millis() wrap");
+  Check(presence.uart_frame(0, t + 300), "pin hold across the wrap");
+  Check(!presence.uart_frame(0, t + 1200), "UART wins after the hold across the wrap");
+}
+
+static void Bench() {
+  PresenceArbiter presence(PIN_HOLD_MS, UART_TIMEOUT_MS);
+  const uint32_t n = 10000000;
+  uint32_t count = 0;
+
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t t = i * 10;
+    if (i % 16 == 0) {
+      count += presence.pin_edge(i & 16, t);
+    }
+    count += presence.uart_frame(i % 3, t);
+  }
+  double ns = (Now_ns() - start) / n;
+
+  printf("uart_frame() + 1/16 pin_edge() %.1f ns (count %u)\n", ns, count);
+}
+
+int main() {
+  Test_fast_path();
+  Test_pin_hold();
+  Test_uart_wins_low_pin();
+  Test_uart_timeout();
+  Test_stale_edge();
+  Test_wrap();
+  printf("\n");
+
+  Bench();
+  return Check_result();
+}
@@ -0,0 +1,146 @@
+/*
+File: radar_frame_bench.cpp
+Host check and benchmark of the binary websocket frame of the
+ESP32_WebConfig example (lib/LD2410/examples/ESP32_WebConfig/RadarFrame.h).
+Round trips random frames through the encoder and decoder, then compares
+size and encode time with the JSON text the example pushed before.
+
+ArduinoJson is not used on the host: the JSON text is written with
+snprintf() byte for byte like serializeJson() wrote it, which is faster
+than building the JsonDocument first, so the time is a lower bound.
+
+  g++ -O2 -std=gnu++17 -Ilib/LD2410/examples/ESP32_WebConfig tools/radar_frame_bench.cpp -o radar_frame_bench
+  ./radar_frame_bench
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RadarFrame.h"
+#include "bench.h"
+
+static RadarFrame Random_frame() {
+  RadarFrame frame;
+  memset(&frame, 0, sizeof(frame));  // padding, the frames are compared with memcmp()
+
+  frame.sequence = rand();
+  frame.radarInEngineeringMode = rand() & 1;
+  frame.targetState = rand() % 4;
+  frame.movingTargetDistance = rand() % 65536;
+  frame.movingTargetEnergy = rand() % 101;
+  frame.stationaryTargetDistance = rand() % 65536;
+  frame.stationaryTargetEnergy = rand() % 101;
+  frame.detectionDistance = rand() % 65536;
+  frame.maxMovingGate = rand() % 9;
+  frame.maxStationaryGate = rand() % 9;
+  frame.maxMovingEnergy = rand() % 101;
+  frame.maxStationaryEnergy = rand() % 101;
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    frame.movingEnergyGateN[gate] = rand() % 101;
+    frame.stationaryEnergyGateN[gate] = rand() % 101;
+  }
+  return frame;
+}
+
+// The JSON text of the example before the binary frames
+static int Json_encode(const RadarFrame &frame, char *buffer, size_t size) {
+  const uint8_t *m = frame.movingEnergyGateN;
+  const uint8_t *s = frame.stationaryEnergyGateN;
+
+  return snprintf(buffer, size,
+                  "{\"radarData\":{\"radarInEngineeringMode\":%s,\"targetState\":%u,"
+                  "\"movingTargetDistance\":%u,\"movingTargetEnergy\":%u,"
+                  "\"stationaryTargetDistance\":%u,\"stationaryTargetEnergy\":%u,"
+                  "\"detectionDistance\":%u},"
+                  "\"engineeringData\":{\"movingEnergyGateN\":[%u,%u,%u,%u,%u,%u,%u,%u,%u],"
+                  "\"stationaryEnergyGateN\":[%u,%u,%u,%u,%u,%u,%u,%u,%u],"
+                  "\"maxMovingGate\":%u,\"maxStationaryGate\":%u,"
+                  "\"maxMovingEnergy\":%u,\"maxStationaryEnergy\":%u}}",
+                  frame.radarInEngineeringMode ? "true" : "false", frame.targetState,
+                  frame.movingTargetDistance, frame.movingTargetEnergy,
+                  frame.stationaryTargetDistance, frame.stationaryTargetEnergy,
+                  frame.detectionDistance,
+                  m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8],
+                  s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8],
+                  frame.maxMovingGate, frame.maxStationaryGate,
+                  frame.maxMovingEnergy, frame.maxStationaryEnergy);
+}
+
+static void Test_round_trip() {
+  uint8_t buffer[RADAR_FRAME_SIZE];
+  bool ok = true;
+
+  for (uint32_t i = 0; i < 100000 && ok; i++) {
+    RadarFrame frame = Random_frame();
+    RadarFrame decoded;
+    memset(&decoded, 0, sizeof(decoded));
+
+    ok = radarFrameEncode(frame, buffer, sizeof(buffer)) == RADAR_FRAME_SIZE &&
+         radarFrameDecode(buffer, sizeof(buffer), decoded) &&
+         !memcmp(&frame, &decoded, sizeof(frame));
+  }
+  Check(ok, "100000 random frames round trip");
+
+  RadarFrame frame = Random_frame();
+  frame.sequence = 0x1234;
+  frame.movingTargetDistance = 0xABCD;
+  radarFrameEncode(frame, buffer, sizeof(buffer));
+  Check(buffer[0] == RADAR_FRAME_VERSION && buffer[1] == RADAR_FRAME_TYPE_CYCLIC &&
+            buffer[2] == 0x34 && buffer[3] == 0x12 && buffer[6] == 0xCD && buffer[7] == 0xAB,
+        "header and little endian fields");
+
+  Check(radarFrameEncode(frame, buffer, RADAR_FRAME_SIZE - 1) == 0, "encode rejects a short buffer");
+
+  RadarFrame decoded;
+  Check(!radarFrameDecode(buffer, RADAR_FRAME_SIZE - 1, decoded), "decode rejects a short frame");
+
+  buffer[0] = RADAR_FRAME_VERSION + 1;
+  Check(!radarFrameDecode(buffer, RADAR_FRAME_SIZE, decoded), "decode rejects an unknown version");
+
+  buffer[0] = RADAR_FRAME_VERSION;
+  buffer[1] = RADAR_FRAME_TYPE_CYCLIC + 1;
+  Check(!radarFrameDecode(buffer, RADAR_FRAME_SIZE, decoded), "decode rejects an unknown type");
+}
+
+static void Bench() {
+  const uint32_t n = 1000000;
+  static RadarFrame frames[256];
+  for (uint16_t i = 0; i < 256; i++) {
+    frames[i] = Random_frame();
+  }
+
+  uint8_t buffer[RADAR_FRAME_SIZE];
+  char json[768];
+  uint32_t checksum = 0;
+  uint64_t json_bytes = 0;
+  int json_min = sizeof(json), json_max = 0;
+
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    radarFrameEncode(frames[i & 255], buffer, sizeof(buffer));
+    checksum += buffer[i % RADAR_FRAME_SIZE];
+  }
+  double binary_ns = (Now_ns() - start) / n;
+
+  start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    int length = Json_encode(frames[i & 255], json, sizeof(json));
+    json_bytes += length;
+    json_min = length < json_min ? length : json_min;
+    json_max = length > json_max ? length : json_max;
+    checksum += json[i % length];
+  }
+  double json_ns = (Now_ns() - start) / n;
+
+  printf("binary: %3u bytes, encode %6.1f ns\n", RADAR_FRAME_SIZE, binary_ns);
+  printf("JSON:   %3.0f bytes (%d-%d), encode %6.1f ns (checksum %u)\n", (double)json_bytes / n, json_min,
+         json_max, json_ns, checksum);
+}
+
+int main() {
+  Test_round_trip();
+  printf("\n");
+
+  Bench();
+  return Check_result();
+}
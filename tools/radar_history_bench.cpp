@@ -0,0 +1,108 @@
+/*
+File: radar_history_bench.cpp
+Host benchmark of include/radar_history.h: cost of add() and of the
+window queries, for short and long windows. Checks the aggregates
+against a brute force scan of the same samples first.
+
+  g++ -O2 -std=gnu++17 -Iinclude tools/radar_history_bench.cpp -o radar_history_bench
+  ./radar_history_bench
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "radar_history.h"
+#include "bench.h"
+
+#define FRAME_MS 100  // LD2410 frame interval
+
+static Radar_sample Random_sample(uint32_t time_ms) {
+  Radar_sample sample;
+  sample.time_ms = time_ms;
+  sample.target_state = rand() % 4;
+  sample.moving_distance = rand() % 600;
+  sample.stationary_distance = rand() % 600;
+  sample.moving_energy = rand() % 101;
+  sample.stationary_energy = rand() % 101;
+  return sample;
+}
+
+// Compare the window aggregates with a scan of the stored samples
+template <uint16_t CAPACITY, uint8_t WINDOWS>
+static bool Same_as_scan(const RadarHistory<CAPACITY, WINDOWS> &history, uint8_t window, uint32_t length_ms) {
+  uint32_t now_ms = history.latest().time_ms;
+
+  for (uint8_t m = 0; m < METRIC_COUNT; m++) {
+    uint16_t count = 0, min = 0xFFFF, max = 0;
+    uint32_t sum = 0;
+
+    for (uint16_t age = 0; age < history.size(); age++) {
+      const Radar_sample &sample = history.latest(age);
+      if (now_ms - sample.time_ms >= length_ms) {
+        break;
+      }
+      uint16_t value = Radar_sample_value(sample, m);
+      count++;
+      sum += value;
+      min = value < min ? value : min;
+      max = value > max ? value : max;
+    }
+
+    if (count != history.count(window) || sum != history.sum(window, m) ||
+        min != history.min(window, m) || max != history.max(window, m)) {
+      printf("mismatch: window %u metric %u\n", window, m);
+      return false;
+    }
+  }
+  return true;
+}
+
+// False if the aggregates differ from the scan
+template <uint16_t CAPACITY>
+static bool Bench(uint32_t length_ms) {
+  static RadarHistory<CAPACITY, 2> history;
+  history.set_window(0, 2000);
+  history.set_window(1, length_ms);
+
+  uint32_t time_ms = 0;
+  for (uint32_t i = 0; i < 10000; i++) {
+    time_ms += FRAME_MS - 20 + rand() % 40;
+    history.add(Random_sample(time_ms));
+    if (!Same_as_scan(history, 0, 2000) || !Same_as_scan(history, 1, length_ms)) {
+      return false;
+    }
+  }
+
+  const uint32_t n = 1000000;
+  static Radar_sample samples[4096];
+  for (uint32_t i = 0; i < 4096; i++) {
+    time_ms += FRAME_MS;
+    samples[i] = Random_sample(time_ms);
+  }
+
+  double start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    Radar_sample sample = samples[i & 4095];
+    sample.time_ms += (i >> 12) * 4096 * FRAME_MS;
+    history.add(sample);
+  }
+  double add_ns = (Now_ns() - start) / n;
+
+  volatile uint32_t sink = 0;
+  start = Now_ns();
+  for (uint32_t i = 0; i < n; i++) {
+    uint8_t m = i & (METRIC_COUNT - 1);
+    sink += history.min(1, m) + history.max(1, m) + history.average(1, m) + history.trend(1, m);
+  }
+  double query_ns = (Now_ns() - start) / n;
+
+  printf("capacity %5u, windows 2 s + %6.1f s (%5u samples): add %6.1f ns, min+max+avg+trend %5.1f ns, %6u bytes\n",
+         CAPACITY, length_ms / 1000.0, history.count(1), add_ns, query_ns, (unsigned)sizeof(history));
+  return true;
+}
+
+int main() {
+  srand(1);
+  bool ok = Bench<128>(10000) && Bench<1024>(100000) && Bench<8192>(800000);
+  Check(ok, "aggregates match a brute force scan");
+  return Check_result();
+}
@@ -0,0 +1,58 @@
+#!/bin/sh
+# File: run_benches.sh
+# Builds and runs the host checks and benchmarks in tools/ with g++.
+# Run from the repository root:
+#
+#   tools/run_benches.sh [build dir]
+#
+# Exits non-zero when a program does not build or a check fails.
+
+BUILD=${1:-_bench_build}
+CXX=${CXX:-g++}
+CXXFLAGS="-O2 -Wall -std=gnu++17"
+
+# Arduino shim and virtual clock for the benches of the LD2410 library
+SIM="-Isim sim/sim_arduino.cpp sim/sim_radar.cpp"
+LD2410="-Ilib/LD2410/src"
+
+mkdir -p "$BUILD" || exit 1
+failed=""
+
+# Bench name compiler arguments...
+Bench() {
+  name=$1
+  shift
+  echo "== $name"
+  if ! $CXX $CXXFLAGS "$@" -o "$BUILD/$name"; then
+    failed="$failed $name"
+  elif ! "$BUILD/$name"; then
+    failed="$failed $name"
+  fi
+  echo
+}
+
+Bench presence_bench -Iinclude tools/presence_bench.cpp src/presence.cpp
+Bench radar_history_bench -Iinclude tools/radar_history_bench.cpp
+Bench light_mapping_bench -Iinclude tools/light_mapping_bench.cpp src/light_mapping.cpp
+Bench clip_bench -Iinclude tools/clip_bench.cpp src/clip.cpp $SIM sim/sim_neopixel.cpp
+Bench led_output_bench -Iinclude tools/led_output_bench.cpp src/led_output.cpp
+Bench ld2410_command_bench $LD2410 tools/ld2410_command_bench.cpp
+# Frame parser once per policy of lib/LD2410/src/LD2410Config.h
+PARSE="$LD2410 tools/ld2410_parse_bench.cpp lib/LD2410/src/LD2410.cpp $SIM"
+Bench ld2410_parse_bench $PARSE
+Bench ld2410_parse_bench_no_engineering -DLD2410_ENGINEERING_MODE=0 $PARSE
+Bench ld2410_parse_bench_no_commands -DLD2410_CONFIG_COMMANDS=0 -DLD2410_READ_COMMANDS=0 $PARSE
+Bench ld2410_parse_bench_presence_only -DLD2410_ENGINEERING_MODE=0 -DLD2410_CONFIG_COMMANDS=0 \
+  -DLD2410_READ_COMMANDS=0 $PARSE
+Bench ld2410_ack_bench $LD2410 tools/ld2410_ack_bench.cpp lib/LD2410/src/LD2410.cpp $SIM
+Bench change_only_bench $LD2410 tools/change_only_bench.cpp lib/LD2410/src/LD2410.cpp $SIM
+Bench background_model_bench $LD2410 tools/background_model_bench.cpp \
+  lib/LD2410/src/LD2410.cpp lib/LD2410/src/LD2410BackgroundModel.cpp $SIM
+Bench radar_frame_bench -Ilib/LD2410/examples/ESP32_WebConfig tools/radar_frame_bench.cpp
+Bench client_push_bench -Ilib/LD2410/examples/ESP32_WebConfig tools/client_push_bench.cpp
+
+if [ -n "$failed" ]; then
+  echo "FAILED:$failed"
+  exit 1
+fi
+echo "all passed"